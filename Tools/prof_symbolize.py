@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""Map a huskEOS profiler histogram to functions using the ELF image.
+
+Input is the bin array written by u4_OSprof_read(): 12-byte little-endian
+records of U4 pc, U4 count, U1 taskID and 3 reserved bytes. Symbols are
+read from the ELF (.axf) with nm, so the image must be the one that was
+running when the samples were taken.
+
+Usage:
+    prof_symbolize.py prof.bin app.axf --per-task --task-name 0=sensor
+    prof_symbolize.py prof.bin app.axf --lines 20
+"""
+
+import argparse
+import bisect
+import collections
+import struct
+import subprocess
+import sys
+
+BIN = struct.Struct("<IIB3x")
+
+# Must match PROF_TASK_ID_* in huskEOS/Profile/Header/prof.h.
+TASK_ID_ISR = 0xFE
+TASK_ID_NONE = 0xFF
+
+CODE_SYMBOL_TYPES = set("tTwW")
+
+
+def read_bins(path):
+    with open(path, "rb") as f:
+        raw = f.read()
+    count = len(raw) // BIN.size
+    bins = [BIN.unpack_from(raw, i * BIN.size) for i in range(count)]
+    return [b for b in bins if b[1] != 0]
+
+
+class SymbolTable:
+    def __init__(self, elf, nm):
+        out = subprocess.run([nm, "-n", "-S", "--defined-only", elf],
+                             check=True, stdout=subprocess.PIPE,
+                             universal_newlines=True).stdout
+        symbols = []
+        for line in out.splitlines():
+            fields = line.split()
+            # addr size type name, or addr type name for symbols without size.
+            if len(fields) == 4:
+                addr, size, kind, name = fields
+                size = int(size, 16)
+            elif len(fields) == 3:
+                addr, kind, name = fields
+                size = None
+            else:
+                continue
+            if kind not in CODE_SYMBOL_TYPES or name.startswith("$"):
+                continue
+            # Thumb function symbols have bit 0 set. Stacked PC does not.
+            symbols.append((int(addr, 16) & ~1, size, name))
+        symbols.sort()
+        self.addrs = [s[0] for s in symbols]
+        self.symbols = symbols
+
+    def lookup(self, pc):
+        i = bisect.bisect_right(self.addrs, pc) - 1
+        if i < 0:
+            return "??"
+        addr, size, name = self.symbols[i]
+        if size is not None and pc >= addr + size:
+            return "??"
+        return name
+
+
+def task_name(names, task):
+    if task == TASK_ID_ISR:
+        return "interrupt"
+    if task == TASK_ID_NONE:
+        return "none"
+    return names.get(task, "task %d" % task)
+
+
+def print_table(title, counts, total, limit):
+    print(title)
+    for name, count in counts.most_common(limit):
+        print("  %6.2f%%  %8d  %s" % (100.0 * count / total, count, name))
+    print()
+
+
+def print_lines(bins, elf, addr2line, total, limit):
+    by_pc = collections.Counter()
+    for pc, count, _task in bins:
+        by_pc[pc] += count
+    top = by_pc.most_common(limit)
+    if not top:
+        return
+    out = subprocess.run([addr2line, "-f", "-C", "-e", elf] + ["0x%x" % pc for pc, _ in top],
+                         check=True, stdout=subprocess.PIPE,
+                         universal_newlines=True).stdout.splitlines()
+    print("hottest PCs")
+    for i, (pc, count) in enumerate(top):
+        func, loc = out[2 * i], out[2 * i + 1]
+        print("  %6.2f%%  %8d  0x%08x  %s  %s" % (100.0 * count / total, count, pc, func, loc))
+    print()
+
+
+def parse_task_name(text):
+    task, sep, name = text.partition("=")
+    if not sep:
+        raise argparse.ArgumentTypeError("expected ID=NAME, got %r" % text)
+    return int(task, 0), name
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="binary histogram dump")
+    parser.add_argument("elf", help="ELF image the samples were taken from")
+    parser.add_argument("--nm", default="arm-none-eabi-nm", help="nm to use")
+    parser.add_argument("--addr2line", default="arm-none-eabi-addr2line",
+                        help="addr2line to use for --lines")
+    parser.add_argument("--top", type=int, default=25,
+                        help="functions listed per table (default: 25)")
+    parser.add_argument("--per-task", action="store_true",
+                        help="also list functions for each task")
+    parser.add_argument("--lines", type=int, default=0, metavar="N",
+                        help="list N hottest PCs with source line")
+    parser.add_argument("--task-name", type=parse_task_name, action="append",
+                        default=[], metavar="ID=NAME",
+                        help="name for task, may be repeated")
+    args = parser.parse_args()
+
+    bins = read_bins(args.input)
+    total = sum(b[1] for b in bins)
+    if total == 0:
+        print("no samples", file=sys.stderr)
+        return 1
+
+    names = dict(args.task_name)
+    symbols = SymbolTable(args.elf, args.nm)
+
+    by_func = collections.Counter()
+    by_task = collections.Counter()
+    by_task_func = collections.defaultdict(collections.Counter)
+    for pc, count, task in bins:
+        func = symbols.lookup(pc)
+        by_func[func] += count
+        by_task[task_name(names, task)] += count
+        by_task_func[task_name(names, task)][func] += count
+
+    print("%d samples in %d bins\n" % (total, len(bins)))
+    print_table("by task", by_task, total, None)
+    print_table("by function", by_func, total, args.top)
+    if args.per_task:
+        for task, count in by_task.most_common():
+            print_table("%s (%d samples)" % (task, count), by_task_func[task], count, args.top)
+    if args.lines:
+        print_lines(bins, args.elf, args.addr2line, total, args.lines)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
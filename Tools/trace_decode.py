@@ -0,0 +1,192 @@
+#!/usr/bin/env python3
+"""Convert a huskEOS kernel trace dump to Chrome trace JSON.
+
+Input is the binary record array written by u4_OStrace_read(): 8-byte
+little-endian records of U4 timestamp, U1 event, U1 taskID, U2 data,
+oldest first. A raw copy of the ring buffer taken with a debugger can be
+used instead by giving the head value (u4_OStrace_getNumRecorded()) with
+--ring-head.
+
+Output opens in https://ui.perfetto.dev or chrome://tracing, with one
+track per task showing when it ran and its kernel events, and one track
+per interrupt.
+
+Usage:
+    trace_decode.py trace.bin -o trace.json --cpu-hz 80000000 \\
+        --task-name 0=sensor --task-name 1=filter
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+RECORD = struct.Struct("<IBBH")
+
+# Must match TRACE_EVT_* in huskEOS/Trace/Header/trace.h.
+EVT_TASK_SWITCH = 1
+EVT_TASK_WAKE = 2
+EVT_TASK_SLEEP = 3
+EVT_PRIO_INHERIT = 4
+EVT_QUEUE_PUT = 5
+EVT_QUEUE_GET = 6
+EVT_ISR_ENTER = 7
+EVT_ISR_EXIT = 8
+
+TASK_ID_NONE = 0xFF
+ISR_TRACK_BASE = 0x1000
+
+# SCH_TASK_WAKEUP_* and SCH_TASK_SLEEP_RESOURCE_* in sch.h / sch_internal_IF.h.
+WAKE_REASONS = {0: "sleep timeout", 1: "mailbox", 2: "queue", 3: "semaphore",
+                4: "flags", 5: "mutex", 6: "notify"}
+SLEEP_RESOURCES = {0: "delay", 1: "mailbox", 2: "queue", 3: "semaphore",
+                   4: "flags", 5: "mutex"}
+EXCEPTION_NAMES = {14: "PendSV", 15: "SysTick"}
+
+
+def read_records(path, ring_head):
+    with open(path, "rb") as f:
+        raw = f.read()
+    count = len(raw) // RECORD.size
+    records = [RECORD.unpack_from(raw, i * RECORD.size) for i in range(count)]
+    if ring_head is not None and count:
+        start = ring_head % count
+        records = records[start:] + records[:start]
+        # Slots not yet written are zero when buffer has not wrapped.
+        records = [r for r in records if r[1] != 0]
+    return records
+
+
+def unwrap_timestamps(records):
+    """Extend 32-bit cycle counts to a monotonic-ish 64-bit timeline.
+
+    Records are in claim order. A record may carry a timestamp a few cycles
+    older than the one before it if it was preempted between claiming its
+    slot and reading the counter, so small backward steps are kept.
+    """
+    out = []
+    total = 0
+    prev = None
+    for ts, event, task, data in records:
+        if prev is not None:
+            delta = (ts - prev) & 0xFFFFFFFF
+            if delta >= 0x80000000:
+                delta -= 0x100000000
+            total += delta
+        prev = ts
+        out.append((total, event, task, data))
+    return out
+
+
+def task_name(names, task):
+    if task == TASK_ID_NONE:
+        return "none"
+    return names.get(task, "task %d" % task)
+
+
+def exception_name(exc):
+    if exc >= 16:
+        return "IRQ %d" % (exc - 16)
+    return EXCEPTION_NAMES.get(exc, "exception %d" % exc)
+
+
+def convert(records, cpu_hz, names):
+    us_per_cycle = 1e6 / cpu_hz
+    events = []
+    tracks = {}
+    running = None
+    run_start = 0.0
+
+    def track(tid, name):
+        if tid not in tracks:
+            tracks[tid] = name
+
+    def instant(ts, tid, name, args):
+        events.append({"name": name, "ph": "i", "s": "t", "ts": ts,
+                       "pid": 1, "tid": tid, "args": args})
+
+    for cycles, event, task, data in records:
+        ts = cycles * us_per_cycle
+
+        if event == EVT_TASK_SWITCH:
+            if running is not None:
+                events.append({"name": task_name(names, running), "ph": "X",
+                               "ts": run_start, "dur": max(ts - run_start, 0.0),
+                               "pid": 1, "tid": running})
+            running = data & 0xFF
+            run_start = ts
+            track(running, task_name(names, running))
+        elif event == EVT_TASK_WAKE:
+            track(task, task_name(names, task))
+            instant(ts, task, "wake", {"reason": WAKE_REASONS.get(data, data)})
+        elif event == EVT_TASK_SLEEP:
+            track(task, task_name(names, task))
+            instant(ts, task, "sleep", {"resource": SLEEP_RESOURCES.get(data, data)})
+        elif event == EVT_PRIO_INHERIT:
+            track(task, task_name(names, task))
+            instant(ts, task, "priority", {"old": data >> 8, "new": data & 0xFF})
+        elif event in (EVT_QUEUE_PUT, EVT_QUEUE_GET):
+            track(task, task_name(names, task))
+            name = "queue put" if event == EVT_QUEUE_PUT else "queue get"
+            instant(ts, task, name, {"queue": data})
+        elif event in (EVT_ISR_ENTER, EVT_ISR_EXIT):
+            tid = ISR_TRACK_BASE + data
+            track(tid, exception_name(data))
+            events.append({"name": exception_name(data),
+                           "ph": "B" if event == EVT_ISR_ENTER else "E",
+                           "ts": ts, "pid": 1, "tid": tid,
+                           "args": {"interrupted": task_name(names, task)}})
+        else:
+            print("warning: unknown event %d skipped" % event, file=sys.stderr)
+
+    if running is not None and records:
+        end = records[-1][0] * us_per_cycle
+        events.append({"name": task_name(names, running), "ph": "X",
+                       "ts": run_start, "dur": max(end - run_start, 0.0),
+                       "pid": 1, "tid": running})
+
+    meta = [{"name": "process_name", "ph": "M", "pid": 1,
+             "args": {"name": "huskEOS"}}]
+    for tid, name in sorted(tracks.items()):
+        meta.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": tid,
+                     "args": {"name": name}})
+        # Task tracks first, ordered by ID, then interrupt tracks.
+        meta.append({"name": "thread_sort_index", "ph": "M", "pid": 1,
+                     "tid": tid, "args": {"sort_index": tid}})
+
+    return {"traceEvents": meta + events, "displayTimeUnit": "ns"}
+
+
+def parse_task_name(text):
+    task, sep, name = text.partition("=")
+    if not sep:
+        raise argparse.ArgumentTypeError("expected ID=NAME, got %r" % text)
+    return int(task, 0), name
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="binary trace dump")
+    parser.add_argument("-o", "--output", default="-",
+                        help="output JSON file (default: stdout)")
+    parser.add_argument("--cpu-hz", type=float, default=80e6,
+                        help="CPU clock used by cycle counter (default: 80 MHz)")
+    parser.add_argument("--ring-head", type=lambda s: int(s, 0),
+                        help="input is raw ring buffer; value of trace head")
+    parser.add_argument("--task-name", type=parse_task_name, action="append",
+                        default=[], metavar="ID=NAME",
+                        help="name for task track, may be repeated")
+    args = parser.parse_args()
+
+    records = unwrap_timestamps(read_records(args.input, args.ring_head))
+    trace = convert(records, args.cpu_hz, dict(args.task_name))
+
+    if args.output == "-":
+        json.dump(trace, sys.stdout)
+    else:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+
+
+if __name__ == "__main__":
+    main()
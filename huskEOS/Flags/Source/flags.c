@@ -58,6 +58,7 @@ U1 u1_OSflags_init(OSFlagsObj** flags, U1 flagInitValues)
          U1 u1_t_index;
          U1 u1_t_returnSts;
   static U1 u1_s_numFlagsAllocated = (U1)ZERO;
+  OS_SCH_CRITICAL_ALLOC();
   
   u1_t_returnSts = (U1)FLAGS_NO_OBJ_AVAILABLE;
   
@@ -108,6 +109,7 @@ U1 u1_OSflags_postFlags(OSFlagsObj* flags, U1 flagMask, U1 set_clear)
 {
   U1 u1_t_returnSts;
   U1 u1_t_index;
+  OS_SCH_CRITICAL_ALLOC();
   
   OS_CPU_ENTER_CRITICAL();
   
@@ -221,6 +223,7 @@ U1 u1_OSflags_pendOnFlags(OSFlagsObj* flags, U1 eventMask, U4 timeOut, U1 eventT
 {
   U1 u1_t_returnSts;
   U1 u1_t_index;
+  OS_SCH_CRITICAL_ALLOC();
   
   u1_t_returnSts = (U1)FLAGS_PEND_LIST_FULL;
   
@@ -282,6 +285,7 @@ U1 u1_OSflags_pendOnFlags(OSFlagsObj* flags, U1 eventMask, U4 timeOut, U1 eventT
 void vd_OSflags_pendTimeout(FlagsObj* flags, struct Sch_Task* pendingTCB)
 {
   U1 u1_t_index;
+  OS_SCH_CRITICAL_ALLOC();
   
   OS_CPU_ENTER_CRITICAL();
   
@@ -313,6 +317,7 @@ void vd_OSflags_pendTimeout(FlagsObj* flags, struct Sch_Task* pendingTCB)
 void vd_OSflags_reset(OSFlagsObj* flags)
 {
   U1 u1_t_index;
+  OS_SCH_CRITICAL_ALLOC();
   
   OS_CPU_ENTER_CRITICAL();
   
@@ -348,6 +353,8 @@ void vd_OSflags_reset(OSFlagsObj* flags)
 /*************************************************************************/
 void vd_OSflags_clearAll(OSFlagsObj* flags)
 {  
+  OS_SCH_CRITICAL_ALLOC();
+  
   OS_CPU_ENTER_CRITICAL();
   
   flags->flags = (U1)FLAGS_RESET_VALUE;
@@ -366,6 +373,7 @@ void vd_OSflags_clearAll(OSFlagsObj* flags)
 U1 u1_OSflags_checkFlags(OSFlagsObj* flags)
 {
   U1 u1_t_returnVal;
+  OS_SCH_CRITICAL_ALLOC();
   
   OS_CPU_ENTER_CRITICAL();
   
@@ -389,3 +397,6 @@ U1 u1_OSflags_checkFlags(OSFlagsObj* flags)
 /*                                                                                             */
 /* 1.0                7/29/19     Re-wrote flags module to handle a user-configured number of  */
 /*                                tasks that can pend on each flags object.                    */
+/*                                                                                             */
+/* 1.1                10/16/26    Critical sections save interrupt mask in caller with         */
+/*                                OS_SCH_CRITICAL_ALLOC().                                     */
@@ -24,10 +24,38 @@
 /* Scheduling */
 #define RTOS_CONFIG_MAX_NUM_TASKS                   (3)                   /* This number of TCBs will be allocated at compile-time, plus any others used by OS */
                                                                           /* Available priorities are 0 - 0xEF with 0 being highest priority. */
+#define RTOS_CONFIG_KERNEL_INT_PRIORITY             (0x20)                /* Critical sections mask interrupts of this priority and lower. Higher priority interrupts are never masked by the OS and must not call OS APIs. */
 #define RTOS_CONFIG_ENABLE_BACKGROUND_IDLE_SLEEP    (RTOS_CONFIG_TRUE)    /* CPU goes to sleep when idle. */
 #define RTOS_CONFIG_ENABLE_STACK_OVERFLOW_DETECT    (RTOS_CONFIG_TRUE)    /* Check for stack overflow periodically. */
+#define RTOS_CONFIG_ENABLE_MPU_STACK_GUARD          (RTOS_CONFIG_FALSE)   /* Read-only MPU region at stack limit of running task replaces periodic check. Writes into it fault, reads do not. Requires RTOS_CONFIG_ENABLE_STACK_OVERFLOW_DETECT. */
+#define RTOS_CONFIG_STACK_FAULT_FUNC                (RTOS_CONFIG_FALSE)   /* If enabled, hook function app_OSStackFaultFcn() is called on MPU stack guard fault. */
+#define RTOS_CONFIG_ENABLE_STACK_WATERMARK          (RTOS_CONFIG_FALSE)   /* Whole stack painted at task creation, minimum free space measured by background task. Requires RTOS_CONFIG_ENABLE_STACK_OVERFLOW_DETECT. */
+#define RTOS_CONFIG_STACK_SCAN_WORDS                (8)                   /* Stack words checked per background task pass. Bounds time interrupts are disabled. */
 #define RTOS_CONFIG_PRESLEEP_FUNC                   (RTOS_CONFIG_FALSE)   /* If enabled, hook function app_OSPreSleepFcn() can be defined in application. */
 #define RTOS_CONFIG_POSTSLEEP_FUNC                  (RTOS_CONFIG_FALSE)   /* If enabled, hook function app_OSPostSleepFcn() can be defined in application. */
+#define RTOS_CONFIG_ENABLE_ROUND_ROBIN              (RTOS_CONFIG_FALSE)   /* Tasks may share a priority level. Equal priority tasks are time sliced. */
+#define RTOS_CONFIG_TIME_SLICE_TICKS                (10)                  /* Round-robin time quantum in scheduler ticks. */
+#define RTOS_CONFIG_ENABLE_EDF_SCHEDULING           (RTOS_CONFIG_FALSE)   /* Earliest-deadline-first. Tasks without a deadline run by priority after all deadline tasks. */
+#define RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD     (RTOS_CONFIG_FALSE)   /* Per-task preemption threshold. Allows run-to-completion tasks to share a stack. */
+#define RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS       (RTOS_CONFIG_FALSE)   /* Per-task CPU cycle accounting in the dispatcher. Uses port cycle counter (DWT CYCCNT). */
+#define RTOS_CONFIG_ENABLE_TASK_NOTIFY              (RTOS_CONFIG_FALSE)   /* Direct-to-task notifications stored in TCB. Lighter than semaphore or flags for one receiver. */
+#define RTOS_CONFIG_ENABLE_PERIODIC_TASKS           (RTOS_CONFIG_FALSE)   /* Periodic tasks released by the kernel at fixed absolute ticks, with jitter and deadline statistics. */
+#define RTOS_CONFIG_ENABLE_PARTITIONS               (RTOS_CONFIG_FALSE)   /* Tasks grouped in partitions, each with a CPU budget per major frame. */
+#define RTOS_CONFIG_NUM_PARTITIONS                  (2)                   /* Number of partitions available. Maximum 32. */
+#define RTOS_CONFIG_PARTITION_MAJOR_FRAME           (100)                 /* Partition budgets are replenished every this many ticks. */
+#define RTOS_CONFIG_ENABLE_SCHEDULE_TABLE           (RTOS_CONFIG_FALSE)   /* Tasks released by SysTick from a static table of offsets in a hyperperiod. */
+#define RTOS_CONFIG_ENABLE_WAKE_BATCH               (RTOS_CONFIG_FALSE)   /* Wake several tasks under one critical section with one preemption check. */
+#define RTOS_CONFIG_ENABLE_DYNAMIC_PRIORITY         (RTOS_CONFIG_FALSE)   /* Application may change task priority at run time. */
+#define RTOS_CONFIG_ENABLE_PRIORITY_TRACE           (RTOS_CONFIG_FALSE)   /* Each task priority change, including priority inheritance, recorded in a trace buffer. */
+#define RTOS_CONFIG_PRIORITY_TRACE_SIZE             (16)                  /* Number of entries in priority trace buffer. Maximum 255. */
+#define RTOS_CONFIG_ENABLE_IDLE_JOBS                (RTOS_CONFIG_FALSE)   /* Application jobs run in steps by background task before CPU sleeps. Uses port cycle counter (DWT CYCCNT). */
+#define RTOS_CONFIG_IDLE_JOB_BUDGET_CYCLES          (10000)               /* Idle job steps are started until this many CPU cycles pass in each background task loop. */
+#define RTOS_CONFIG_ENABLE_IDLE_GOVERNOR            (RTOS_CONFIG_FALSE)   /* Sleep state picked from predicted idle length. Requires RTOS_CONFIG_ENABLE_TICKLESS_IDLE and RTOS_CONFIG_PRESLEEP_FUNC. */
+#define RTOS_CONFIG_IDLE_NUM_SLEEP_STATES           (3)                   /* Number of sleep states application may register with idle governor. */
+#define RTOS_CONFIG_ENABLE_TICK_TASK                (RTOS_CONFIG_FALSE)   /* SysTick only counts time. Sleep and resource timeouts are processed by a kernel task. */
+#define RTOS_CONFIG_TICK_TASK_PRIORITY              (0)                   /* Priority of kernel tick task. Should be above all application tasks. Reserved, application tasks are denied this priority. */
+#define RTOS_CONFIG_TICK_TASK_STACK_SIZE            (100)                 /* Stack size for kernel tick task if enabled. */
+#define RTOS_CONFIG_ENABLE_TICKLESS_IDLE            (RTOS_CONFIG_FALSE)   /* SysTick stretched to next wake-up while idle. Requires RTOS_CONFIG_ENABLE_BACKGROUND_IDLE_SLEEP. */
 
 /* Mailbox */
 #define RTOS_CFG_OS_MAILBOX_ENABLED                 (RTOS_CONFIG_FALSE)
@@ -63,6 +91,15 @@
 #define RTOS_CFG_MAX_MEM_BLOCK_SIZE                 (0)                  /* Maximum memory block size. */
 #define RTOS_CFG_MEMORY_TYPE                        U1                   /* Type of data to use in the memory module. */
 
+/* Trace */
+#define RTOS_CFG_OS_TRACE_ENABLED                   (RTOS_CONFIG_FALSE)   /* Kernel events recorded to RAM ring buffer. Uses port cycle counter (DWT CYCCNT). */
+#define RTOS_CFG_TRACE_BUFFER_SIZE                  (256)                 /* Number of 8-byte trace records. Must be a power of two. */
+
+/* Profiler */
+#define RTOS_CFG_OS_PROFILE_ENABLED                 (RTOS_CONFIG_FALSE)   /* PC and task ID of interrupted code sampled on system tick and binned in a hash table. */
+#define RTOS_CFG_PROFILE_TABLE_SIZE                 (128)                 /* Number of distinct PC/task bins. Must be a power of two. */
+#define RTOS_CFG_PROFILE_TICK_DIVIDER               (1)                   /* Sample taken every Nth tick. Sets profiling overhead. */
+
 /* I/O */
 #define PART_TM4C123GH6PM 1
 
@@ -9,7 +9,7 @@
 #ifndef TaskList_Node_h 
 #define TaskList_Node_h
 
-#include "cpu_defs.h"
+#include "rtos_cfg.h"
 
 /*************************************************************************/
 /*  Definitions                                                          */
@@ -53,6 +53,19 @@ void vd_list_addNodeToEnd(struct ListNode** listHead, struct ListNode* newNode);
 /*************************************************************************/
 void vd_list_addTaskByPrio(struct ListNode** listHead, struct ListNode* newNode);
 
+/*************************************************************************/
+/*  Function Name: vd_list_addTaskByDeadline                             */
+/*  Purpose:       Add task to a queue by order of absolute deadline.    */
+/*                 Tasks without a deadline are placed after all tasks   */
+/*                 with one, in order of priority.                       */
+/*  Arguments:     ListNode** listHead, newNode:                         */
+/*                     Pointers to head node and new node.               */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+void vd_list_addTaskByDeadline(struct ListNode** listHead, struct ListNode* newNode);
+#endif
+
 /*************************************************************************/
 /*  Function Name: vd_list_addNodeToFront                                */
 /*  Purpose:       Add node to front of linked list.                     */
@@ -97,6 +110,32 @@ ListNode* node_list_removeFirstNode(struct ListNode** listHead);
 /*************************************************************************/
 ListNode* node_list_removeNodeByTCB(struct ListNode** listHead, struct Sch_Task* taskTCB);
 
+/*************************************************************************/
+/*  Function Name: vd_list_addNodeByDelta                                */
+/*  Purpose:       Add node to delta list ordered by expiry time. Each   */
+/*                 TCB sleepCntr in list holds ticks relative to the     */
+/*                 previous node, so only the head must be decremented.  */
+/*  Arguments:     ListNode** listHead:                                  */
+/*                     Pointer of head node.                             */
+/*                 ListNode* newNode:                                    */
+/*                     Node to be added. TCB sleepCntr must hold ticks   */
+/*                     from now, and is converted to relative ticks.     */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_list_addNodeByDelta(struct ListNode** listHead, struct ListNode* newNode);
+
+/*************************************************************************/
+/*  Function Name: vd_list_removeDeltaNode                               */
+/*  Purpose:       Remove a node from delta list and carry its remaining */
+/*                 ticks over to the next node.                          */
+/*  Arguments:     ListNode** listHead:                                  */
+/*                     Pointer of head node.                             */
+/*                 ListNode* removeNode:                                 */
+/*                     Pointer to node to remove.                        */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_list_removeDeltaNode(struct ListNode** listHead, struct ListNode* removeNode);
+
 /*************************************************************************/
 /*  Global Variables                                                     */
 /*************************************************************************/
@@ -37,6 +37,10 @@
 /*************************************************************************/
 /*  Private Function Prototypes                                          */
 /*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+static U1 u1_list_deadlinePrecedes(struct Sch_Task* taskA, struct Sch_Task* taskB);
+static U1 u1_list_taskDeadline(struct Sch_Task* task, U4* deadline);
+#endif
 
 
 /*************************************************************************/
@@ -139,6 +143,49 @@ void vd_list_addTaskByPrio(struct ListNode** listHead, struct ListNode* newNode)
   }
 }
 
+/*************************************************************************/
+/*  Function Name: vd_list_addTaskByDeadline                             */
+/*  Purpose:       Add task to a queue by order of absolute deadline.    */
+/*                 Tasks without a deadline are placed after all tasks   */
+/*                 with one, in order of priority.                       */
+/*  Arguments:     ListNode** listHead, newNode:                         */
+/*                     Pointers to head node and new node.               */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+void vd_list_addTaskByDeadline(struct ListNode** listHead, struct ListNode* newNode)
+{
+  ListNode* node_t_tempPtr;
+  
+  /* List is empty or new node precedes current head */
+  if((*listHead == LIST_NULL_PTR) || (u1_list_deadlinePrecedes(newNode->TCB, (*listHead)->TCB)))
+  {
+    vd_list_addNodeToFront(listHead, newNode);
+  }
+  else
+  {
+    node_t_tempPtr = (*listHead);
+    
+    /* Find insertion point. Tasks with equal deadlines keep insertion order. */
+    while((node_t_tempPtr->nextNode != LIST_NULL_PTR) && !(u1_list_deadlinePrecedes(newNode->TCB, node_t_tempPtr->nextNode->TCB)))
+    {
+      node_t_tempPtr = node_t_tempPtr->nextNode;
+    }
+    
+    /* Link new node after insertion point */
+    newNode->nextNode     = node_t_tempPtr->nextNode;
+    newNode->previousNode = node_t_tempPtr;
+    
+    if(newNode->nextNode != LIST_NULL_PTR)
+    {
+      newNode->nextNode->previousNode = newNode;
+    }
+    
+    node_t_tempPtr->nextNode = newNode;
+  }
+}
+#endif
+
 /*************************************************************************/
 /*  Function Name: vd_list_addNodeToFront                                */
 /*  Purpose:       Add node to front of linked list.                     */
@@ -280,6 +327,169 @@ ListNode* node_list_removeNodeByTCB(struct ListNode** listHead, struct Sch_Task*
   return(node_t_tempPtr);  
 }
 
+/*************************************************************************/
+/*  Function Name: vd_list_addNodeByDelta                                */
+/*  Purpose:       Add node to delta list ordered by expiry time. Each   */
+/*                 TCB sleepCntr in list holds ticks relative to the     */
+/*                 previous node, so only the head must be decremented.  */
+/*  Arguments:     ListNode** listHead:                                  */
+/*                     Pointer of head node.                             */
+/*                 ListNode* newNode:                                    */
+/*                     Node to be added. TCB sleepCntr must hold ticks   */
+/*                     from now, and is converted to relative ticks.     */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_list_addNodeByDelta(struct ListNode** listHead, struct ListNode* newNode)
+{
+  ListNode* node_t_tempPtr;
+  U4        u4_t_remaining;
+  
+  u4_t_remaining = newNode->TCB->sleepCntr;
+  
+  /* List is empty */
+  if(*listHead == LIST_NULL_PTR)
+  {
+    vd_list_addNodeToFront(listHead, newNode);
+  }
+  /* New node expires before current head */
+  else if(u4_t_remaining < (*listHead)->TCB->sleepCntr)
+  {
+    (*listHead)->TCB->sleepCntr -= u4_t_remaining;
+    vd_list_addNodeToFront(listHead, newNode);
+  }
+  else
+  {
+    node_t_tempPtr  = *listHead;
+    u4_t_remaining -= node_t_tempPtr->TCB->sleepCntr;
+    
+    /* Find insertion point. Nodes with equal expiry keep insertion order. */
+    while((node_t_tempPtr->nextNode != LIST_NULL_PTR) && (u4_t_remaining >= node_t_tempPtr->nextNode->TCB->sleepCntr))
+    {
+      node_t_tempPtr  = node_t_tempPtr->nextNode;
+      u4_t_remaining -= node_t_tempPtr->TCB->sleepCntr;
+    }
+    
+    /* Link new node after insertion point */
+    newNode->nextNode     = node_t_tempPtr->nextNode;
+    newNode->previousNode = node_t_tempPtr;
+    
+    if(newNode->nextNode != LIST_NULL_PTR)
+    {
+      newNode->nextNode->previousNode = newNode;
+      newNode->nextNode->TCB->sleepCntr -= u4_t_remaining;
+    }
+    
+    node_t_tempPtr->nextNode = newNode;
+  }
+  
+  newNode->TCB->sleepCntr = u4_t_remaining;
+}
+
+/*************************************************************************/
+/*  Function Name: vd_list_removeDeltaNode                               */
+/*  Purpose:       Remove a node from delta list and carry its remaining */
+/*                 ticks over to the next node.                          */
+/*  Arguments:     ListNode** listHead:                                  */
+/*                     Pointer of head node.                             */
+/*                 ListNode* removeNode:                                 */
+/*                     Pointer to node to remove.                        */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_list_removeDeltaNode(struct ListNode** listHead, struct ListNode* removeNode)
+{
+  if(removeNode->nextNode != LIST_NULL_PTR)
+  {
+    removeNode->nextNode->TCB->sleepCntr += removeNode->TCB->sleepCntr;
+  }
+  
+  vd_list_removeNode(listHead, removeNode);
+}
+
+/*************************************************************************/
+/*  Function Name: u1_list_deadlinePrecedes                              */
+/*  Purpose:       Check if task A must run before task B under EDF.     */
+/*                 Deadline comparison is safe across tick roll-over.    */
+/*                 Deadline inherited through a mutex is included.       */
+/*  Arguments:     Sch_Task* taskA, taskB:                               */
+/*                     Pointers to TCBs to be compared.                  */
+/*  Return:        U1: ONE if task A strictly precedes task B, else ZERO.*/
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+static U1 u1_list_deadlinePrecedes(struct Sch_Task* taskA, struct Sch_Task* taskB)
+{
+  U1 u1_t_return;
+  U1 u1_t_hasDeadlineA;
+  U1 u1_t_hasDeadlineB;
+  U4 u4_t_deadlineA;
+  U4 u4_t_deadlineB;
+  
+  u1_t_hasDeadlineA = u1_list_taskDeadline(taskA, &u4_t_deadlineA);
+  u1_t_hasDeadlineB = u1_list_taskDeadline(taskB, &u4_t_deadlineB);
+  
+  if(u1_t_hasDeadlineA)
+  {
+    if(u1_t_hasDeadlineB == (U1)ZERO)
+    {
+      u1_t_return = (U1)ONE;
+    }
+    else
+    {
+      u1_t_return = (U1)((S4)(u4_t_deadlineA - u4_t_deadlineB) < (S4)ZERO);
+    }
+  }
+  else if(u1_t_hasDeadlineB)
+  {
+    u1_t_return = (U1)ZERO;
+  }
+  else
+  {
+    u1_t_return = (U1)(taskA->priority < taskB->priority);
+  }
+  
+  return (u1_t_return);
+}
+
+/*************************************************************************/
+/*  Function Name: u1_list_taskDeadline                                  */
+/*  Purpose:       Get deadline task is scheduled by. This is the        */
+/*                 earlier of its own and its inherited deadline.        */
+/*  Arguments:     Sch_Task* task:                                       */
+/*                     Pointer to TCB.                                   */
+/*                 U4* deadline:                                         */
+/*                     Absolute deadline is written here.                */
+/*  Return:        U1: ONE if task has a deadline, else ZERO.            */
+/*************************************************************************/
+static U1 u1_list_taskDeadline(struct Sch_Task* task, U4* deadline)
+{
+  U1 u1_t_hasDeadline;
+  
+  if(task->relDeadline != (U4)ZERO)
+  {
+    u1_t_hasDeadline = (U1)ONE;
+    
+    if((task->deadlineInherited) && ((S4)(task->inheritedDeadline - task->absDeadline) < (S4)ZERO))
+    {
+      *deadline = task->inheritedDeadline;
+    }
+    else
+    {
+      *deadline = task->absDeadline;
+    }
+  }
+  else if(task->deadlineInherited)
+  {
+    u1_t_hasDeadline = (U1)ONE;
+    *deadline        = task->inheritedDeadline;
+  }
+  else
+  {
+    u1_t_hasDeadline = (U1)ZERO;
+  }
+  
+  return (u1_t_hasDeadline);
+}
+#endif
+
 /***********************************************************************************************/
 /* History                                                                                     */
 /***********************************************************************************************/
@@ -287,3 +497,9 @@ ListNode* node_list_removeNodeByTCB(struct ListNode** listHead, struct Sch_Task*
 /*                                                                                             */
 /* 0.1                7/17/19     Added routines to support task queue management for scheduler*/
 /*                                version 2.x. Still in work.                                  */
+/*                                                                                             */
+/* 0.2                10/16/26    Added delta list routines for scheduler sleep list.          */
+/*                                                                                             */
+/* 0.3                10/16/26    Added deadline-ordered insertion for EDF scheduling.         */
+/*                                                                                             */
+/* 0.4                10/16/26    EDF order uses earlier of own and inherited deadline.        */
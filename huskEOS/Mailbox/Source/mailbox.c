@@ -79,6 +79,7 @@ void vd_OSmbox_init(void)
 MAIL mail_OSmbox_getMail(U1 mailbox, U4 blockPeriod, U1* errorCode)
 {
   MAIL mail_t_data;
+  OS_SCH_CRITICAL_ALLOC();
   
   *errorCode = u1_OSmbox_checkValidMailbox(mailbox);
 
@@ -159,6 +160,7 @@ MAIL mail_OSmbox_getMail(U1 mailbox, U4 blockPeriod, U1* errorCode)
 MAIL mail_OSmbox_checkMail(U1 mailbox, U1* errorCode)
 {
   MAIL mail_t_data;
+  OS_SCH_CRITICAL_ALLOC();
   
   *errorCode = u1_OSmbox_checkValidMailbox(mailbox);
 
@@ -204,6 +206,7 @@ MAIL mail_OSmbox_checkMail(U1 mailbox, U1* errorCode)
 U1 u1_OSmbox_sendMail(U1 mailbox, U4 blockPeriod, MAIL data, U1* errorCode)
 { 
   U1 u1_t_return;
+  OS_SCH_CRITICAL_ALLOC();
   
   *errorCode = u1_OSmbox_checkValidMailbox(mailbox);
 
@@ -284,6 +287,8 @@ U1 u1_OSmbox_sendMail(U1 mailbox, U4 blockPeriod, MAIL data, U1* errorCode)
 /*************************************************************************/
 void vd_OSmbox_clearMailbox(U1 mailbox)
 {
+  OS_SCH_CRITICAL_ALLOC();
+  
   if(u1_OSmbox_checkValidMailbox(mailbox))    
   {
 
@@ -399,3 +404,6 @@ static void vd_OSmbox_unblockWaitingTask(U1 mailboxID)
 /* 0.1                3/4/19      Mailboxes with blocked task implemented.                     */
 /*                                                                                             */
 /* 1.0                8/3/19      Updated for better software flow and block handling.         */
+/*                                                                                             */
+/* 1.1                10/16/26    Critical sections save interrupt mask in caller with         */
+/*                                OS_SCH_CRITICAL_ALLOC().                                     */
@@ -65,6 +65,7 @@ U1 u1_OSMem_PartitionInit(MEMTYPE* partitionMatrix, U1 blockSize, U1 numBlocks,
 {
 	U1  blockIndex     = 0;
 	U1* tempBlockStart = NULL;
+	OS_SCH_CRITICAL_ALLOC();
 	
 	/* cant exceed the maximum block size or maximum number of blocks */
 	if(blockSize > MEM_MAX_BLOCK_SIZE ||
@@ -130,6 +131,7 @@ MEMTYPE* data_OSMem_malloc(U1 sizeRequested, U1* err)
 	U1 partitionIndex = 0;
 	U1 blockIndex     = 0;
 	U1 byteIndex      = 0;
+	OS_SCH_CRITICAL_ALLOC();
 	
 	/* check to see if the user requested more memory than possible */
 	if(sizeRequested > largestBlockSize)
@@ -205,6 +207,7 @@ MEMTYPE* data_OSMem_calloc(U1 sizeRequested, U1* err)
 	U1 partitionIndex = 0;
 	U1 blockIndex     = 0;
 	U1 byteIndex      = 0;
+	OS_SCH_CRITICAL_ALLOC();
 	
 	/* check to see if the user requested more memory than possible */
 	if(sizeRequested > largestBlockSize)
@@ -284,6 +287,7 @@ void v_OSMem_free(MEMTYPE** memToFree, U1* err)
 	U1 partitionIndex      = 0;
 	U1 blockIndex          = 0;
 	MEMTYPE* blockStart    = NULL;
+	OS_SCH_CRITICAL_ALLOC();
 	
 	/* find the block currently in use by the heap */
 	for(partitionIndex = 0; partitionIndex < numPartitionsAllocated; partitionIndex++)
@@ -344,6 +348,7 @@ MEMTYPE* data_OSMem_realloc(MEMTYPE* oldPointer, U1 newSize, U1* err)
 	U1  loopLength          = 0;
 	U1  byteIndex           = 0;	
 	MEMTYPE* newPointer     = NULL;
+	OS_SCH_CRITICAL_ALLOC();
 	
 	/* find size of old memory block */
 	U1 oldBlockSize = u1_OSMem_findBlockSize(oldPointer, &localError);
@@ -537,3 +542,6 @@ U1 u1_OSMem_maintenance()
 /* 2.2                05/07/20    Moved static variables from memory internal to memory.c.     */
 /*                                                                                             */
 /* 2.3                07/12/20    Changed memory module datatype to be user defined.           */
+/*                                                                                             */
+/* 2.4                10/16/26    Critical sections save interrupt mask in caller with         */
+/*                                OS_SCH_CRITICAL_ALLOC().                                     */
@@ -63,6 +63,29 @@ Mutex;
 /*************************************************************************/
 void vd_OSmutex_blockedTimeout(struct Mutex* mutex, struct Sch_Task* taskTCB);
 
+/*************************************************************************/
+/*  Function Name: u1_OSmutex_getNumHeld                                 */
+/*  Purpose:       API for scheduler to check if task owns any mutex     */
+/*                 before task is deleted or restarted.                  */
+/*  Arguments:     Sch_Task* taskTCB:                                    */
+/*                     Pointer to TCB of task.                           */
+/*  Return:        U1: Number of mutexes held by task.                   */
+/*************************************************************************/
+U1 u1_OSmutex_getNumHeld(struct Sch_Task* taskTCB);
+
+/*************************************************************************/
+/*  Function Name: vd_OSmutex_blockedPriorityChange                      */
+/*  Purpose:       API for scheduler to call when priority of a task     */
+/*                 blocked on mutex is changed. Blocked list is sorted   */
+/*                 again and holder inherits or gives up priority.       */
+/*  Arguments:     Mutex* mutex:                                         */
+/*                     Pointer to mutex.                                 */
+/*                 Sch_Task* taskTCB:                                    */
+/*                     Pointer to TCB of blocked task.                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSmutex_blockedPriorityChange(struct Mutex* mutex, struct Sch_Task* taskTCB);
+
 /*************************************************************************/
 /*  Global Variables                                                     */
 /*************************************************************************/
@@ -42,6 +42,9 @@ static Mutex mutex_s_mutexList[MUTEX_NUM_MUTEXES];
 /*************************************************************************/
 static void vd_OSmutex_blockTask(struct Mutex* mutex);
 static void vd_OSmutex_unblockTask(struct Mutex* mutex);
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+static void vd_OSmutex_updateInheritedDeadline(struct Sch_Task* holderTCB);
+#endif
 
 
 /*************************************************************************/
@@ -61,6 +64,7 @@ U1 u1_OSmutex_init(OSMutex** mutex, U1 initValue)
          U1 u1_t_index;
          U1 u1_t_returnSts; 
   static U1 u1_s_numMutexAllocated = (U1)ZERO;
+  OS_SCH_CRITICAL_ALLOC();
   
   u1_t_returnSts = (U1)MUTEX_NO_OBJECTS_AVAILABLE;
   
@@ -111,6 +115,7 @@ U1 u1_OSmutex_init(OSMutex** mutex, U1 initValue)
 U1 u1_OSmutex_lock(OSMutex* mutex, U4 blockPeriod)
 {
   U1 u1_t_returnSts;
+  OS_SCH_CRITICAL_ALLOC();
   
   u1_t_returnSts = (U1)MUTEX_TAKEN;
   
@@ -143,6 +148,11 @@ U1 u1_OSmutex_lock(OSMutex* mutex, U4 blockPeriod)
         --(mutex->lock);      
         mutex->priority.mutexHolder = SCH_CURRENT_TCB_ADDR;    
         u1_t_returnSts              = (U1)MUTEX_SUCCESS;        
+        
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+        /* Tasks still blocked on mutex now wait on this task. */
+        vd_OSmutex_updateInheritedDeadline(SCH_CURRENT_TCB_ADDR);
+#endif
       }
       
       OS_SCH_EXIT_CRITICAL();
@@ -171,6 +181,7 @@ U1 u1_OSmutex_lock(OSMutex* mutex, U4 blockPeriod)
 U1 u1_OSmutex_check(OSMutex* mutex)
 {
   U1 u1_t_sts;
+  OS_SCH_CRITICAL_ALLOC();
   
   u1_t_sts = (U1)MUTEX_TAKEN;
   
@@ -206,6 +217,7 @@ U1 u1_OSmutex_check(OSMutex* mutex)
 U1 u1_OSmutex_unlock(OSMutex* mutex)
 {
   U1 u1_t_return;
+  OS_SCH_CRITICAL_ALLOC();
   
   OS_SCH_ENTER_CRITICAL();
   
@@ -218,6 +230,11 @@ U1 u1_OSmutex_unlock(OSMutex* mutex)
     if(mutex->blockedTaskList.blockedListHead != MUTEX_NULL_PTR)
     {
       vd_OSmutex_unblockTask(mutex);
+      
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+      /* Drop deadline inherited through this mutex. */
+      vd_OSmutex_updateInheritedDeadline(SCH_CURRENT_TCB_ADDR);
+#endif
     }
     else
     {
@@ -249,6 +266,7 @@ void vd_OSmutex_blockedTimeout(struct Mutex* mutex, struct Sch_Task* taskTCB)
 {
   ListNode* node_t_tempPtr;
   U1        u1_t_newMutexHolderPrio;
+  OS_SCH_CRITICAL_ALLOC();
   
   OS_SCH_ENTER_CRITICAL();
   
@@ -269,8 +287,9 @@ void vd_OSmutex_blockedTimeout(struct Mutex* mutex, struct Sch_Task* taskTCB)
     }
     else
     {
-      /* If the new highest prio blocked task priority is greater (numerically lower) than the current inherited priority, update the inherited priority. */
-      if(mutex->blockedTaskList.blockedListHead->TCB->priority < mutex->priority.taskInheritedPrio)
+      /* If the new highest prio blocked task priority is greater than or equal to (numerically lower or equal) the current inherited priority, keep inheriting it. 
+         Equal priorities can occur when round-robin scheduling is enabled. */
+      if(mutex->blockedTaskList.blockedListHead->TCB->priority <= mutex->priority.taskInheritedPrio)
       {    
         /* Update inherited priority. */
         u1_t_newMutexHolderPrio = mutex->blockedTaskList.blockedListHead->TCB->priority;
@@ -298,13 +317,130 @@ void vd_OSmutex_blockedTimeout(struct Mutex* mutex, struct Sch_Task* taskTCB)
   
   node_t_tempPtr->TCB = MUTEX_NULL_PTR;
   
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+  if(mutex->priority.mutexHolder != MUTEX_NULL_PTR)
+  {
+    vd_OSmutex_updateInheritedDeadline(mutex->priority.mutexHolder);
+  }
+  else
+  {
+    
+  }
+#endif
+  
+  OS_SCH_EXIT_CRITICAL();
+}
+
+/*************************************************************************/
+/*  Function Name: u1_OSmutex_getNumHeld                                 */
+/*  Purpose:       API for scheduler to check if task owns any mutex     */
+/*                 before task is deleted or restarted.                  */
+/*  Arguments:     Sch_Task* taskTCB:                                    */
+/*                     Pointer to TCB of task.                           */
+/*  Return:        U1: Number of mutexes held by task.                   */
+/*************************************************************************/
+U1 u1_OSmutex_getNumHeld(struct Sch_Task* taskTCB)
+{
+  U1 u1_t_index;
+  U1 u1_t_numHeld;
+  OS_SCH_CRITICAL_ALLOC();
+  
+  u1_t_numHeld = (U1)ZERO;
+  
+  OS_SCH_ENTER_CRITICAL();
+  
+  /* Holder is left set after unlock if no task was waiting, so lock value is checked too. */
+  for(u1_t_index = (U1)ZERO; u1_t_index < (U1)MUTEX_NUM_MUTEXES; u1_t_index++)
+  {
+    if((mutex_s_mutexList[u1_t_index].lock == (U1)MUTEX_TAKEN) && (mutex_s_mutexList[u1_t_index].priority.mutexHolder == taskTCB))
+    {
+      ++u1_t_numHeld;
+    }
+    else{}
+  }
+  
+  OS_SCH_EXIT_CRITICAL();
+  
+  return (u1_t_numHeld);
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSmutex_blockedPriorityChange                      */
+/*  Purpose:       API for scheduler to call when priority of a task     */
+/*                 blocked on mutex is changed.                          */
+/*  Arguments:     Mutex* mutex:                                         */
+/*                     Pointer to mutex.                                 */
+/*                 Sch_Task* taskTCB:                                    */
+/*                     Pointer to TCB of blocked task.                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSmutex_blockedPriorityChange(struct Mutex* mutex, struct Sch_Task* taskTCB)
+{
+  ListNode* node_t_tempPtr;
+  U1        u1_t_realPrio;
+  U1        u1_t_newMutexHolderPrio;
+  OS_SCH_CRITICAL_ALLOC();
+  
+  OS_SCH_ENTER_CRITICAL();
+  
+  /* Move task to its new place in blocked list. */
+  node_t_tempPtr = node_list_removeNodeByTCB(&(mutex->blockedTaskList.blockedListHead), taskTCB);
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+  vd_list_addTaskByDeadline(&(mutex->blockedTaskList.blockedListHead), node_t_tempPtr);
+#else
+  vd_list_addTaskByPrio(&(mutex->blockedTaskList.blockedListHead), node_t_tempPtr);
+#endif
+  
+  /* Holder is cleared while mutex is handed to a woken task. */
+  if(mutex->priority.mutexHolder != MUTEX_NULL_PTR)
+  {
+    /* Priority of holder without inheritance. */
+    if(mutex->priority.taskRealPrio != (U1)MUTEX_DEFAULT_PRIO)
+    {
+      u1_t_realPrio = mutex->priority.taskRealPrio;
+    }
+    else
+    {
+      u1_t_realPrio = mutex->priority.mutexHolder->priority;
+    }
+    
+    /* Inherit priority of first blocked task if it is higher (numerically lower). */
+    if(mutex->blockedTaskList.blockedListHead->TCB->priority < u1_t_realPrio)
+    {
+      u1_t_newMutexHolderPrio           = mutex->blockedTaskList.blockedListHead->TCB->priority;
+      mutex->priority.taskRealPrio      = u1_t_realPrio;
+      mutex->priority.taskInheritedPrio = u1_t_newMutexHolderPrio;
+    }
+    else
+    {
+      u1_t_newMutexHolderPrio           = u1_t_realPrio;
+      mutex->priority.taskRealPrio      = (U1)MUTEX_DEFAULT_PRIO;
+      mutex->priority.taskInheritedPrio = (U1)MUTEX_DEFAULT_PRIO;
+    }
+    
+    /* Notify scheduler of change. */
+    if(u1_t_newMutexHolderPrio != mutex->priority.mutexHolder->priority)
+    {
+      (void)u1_OSsch_setNewPriority(mutex->priority.mutexHolder, u1_t_newMutexHolderPrio);
+    }
+    else
+    {
+      
+    }
+  }
+  else
+  {
+    
+  }
+  
   OS_SCH_EXIT_CRITICAL();
 }
 
 /*************************************************************************/
 /*  Function Name: vd_OSmutex_blockTask                                  */
 /*  Purpose:       Add task to blocked list of mutex and handle priority */
-/*                 inheritance.                                          */
+/*                 inheritance. Under EDF, list is ordered by deadline   */
+/*                 and holder inherits deadline of first blocked task.   */
 /*  Arguments:     OSMutex* mutex:                                       */
 /*                     Pointer to mutex.                                 */
 /*  Return:        N/A                                                   */
@@ -326,7 +462,11 @@ static void vd_OSmutex_blockTask(OSMutex* mutex)
   {
     /* Add task to blocked list. */
     (mutex->blockedTaskList.blockedTasks[u1_t_index].TCB) = SCH_CURRENT_TCB_ADDR;
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+    vd_list_addTaskByDeadline(&(mutex->blockedTaskList.blockedListHead), &(mutex->blockedTaskList.blockedTasks[u1_t_index]));
+#else
     vd_list_addTaskByPrio(&(mutex->blockedTaskList.blockedListHead), &(mutex->blockedTaskList.blockedTasks[u1_t_index]));
+#endif
     
     /* If the blocking task's priority is greater (numerically lower) than the mutex holder's current priority, update the inherited priority. */
     if((mutex->blockedTaskList.blockedListHead->TCB->priority != mutex->priority.taskInheritedPrio) 
@@ -353,6 +493,17 @@ static void vd_OSmutex_blockTask(OSMutex* mutex)
     {
       
     }/* (mutex->blockedTaskList.blockedListHead->TCB->priority < mutex->priority.taskInheritedPrio) */
+    
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+    if(mutex->priority.mutexHolder != MUTEX_NULL_PTR)
+    {
+      vd_OSmutex_updateInheritedDeadline(mutex->priority.mutexHolder);
+    }
+    else
+    {
+      
+    }
+#endif
   }/* (u1_t_index < (U1)MUTEX_MAX_NUM_BLOCKED) */
 }
 
@@ -395,6 +546,55 @@ static void vd_OSmutex_unblockTask(OSMutex* mutex)
   node_t_p_highPrioTask->TCB = MUTEX_NULL_PTR;   
 }
 
+/*************************************************************************/
+/*  Function Name: vd_OSmutex_updateInheritedDeadline                    */
+/*  Purpose:       Give task the earliest deadline of tasks blocked on   */
+/*                 mutexes it holds, or its own deadline if no deadline  */
+/*                 task is blocked. Head of each blocked list has the    */
+/*                 earliest deadline. Not transitive.                    */
+/*  Arguments:     Sch_Task* holderTCB:                                  */
+/*                     Pointer to TCB of mutex holder.                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+static void vd_OSmutex_updateInheritedDeadline(struct Sch_Task* holderTCB)
+{
+  U1               u1_t_index;
+  U1               u1_t_inherit;
+  U4               u4_t_deadline;
+  struct Sch_Task* tcb_t_p_waiter;
+  
+  u1_t_inherit  = (U1)ZERO;
+  u4_t_deadline = (U4)ZERO;
+  
+  for(u1_t_index = (U1)ZERO; u1_t_index < (U1)MUTEX_NUM_MUTEXES; u1_t_index++)
+  {
+    if((mutex_s_mutexList[u1_t_index].lock == (U1)MUTEX_TAKEN) && (mutex_s_mutexList[u1_t_index].priority.mutexHolder == holderTCB) &&
+       (mutex_s_mutexList[u1_t_index].blockedTaskList.blockedListHead != MUTEX_NULL_PTR))
+    {
+      tcb_t_p_waiter = mutex_s_mutexList[u1_t_index].blockedTaskList.blockedListHead->TCB;
+      
+      if((tcb_t_p_waiter->relDeadline != (U4)ZERO) &&
+         ((u1_t_inherit == (U1)ZERO) || ((S4)(tcb_t_p_waiter->absDeadline - u4_t_deadline) < (S4)ZERO)))
+      {
+        u1_t_inherit  = (U1)ONE;
+        u4_t_deadline = tcb_t_p_waiter->absDeadline;
+      }
+      else
+      {
+        
+      }
+    }
+    else
+    {
+      
+    }
+  }
+  
+  vd_OSsch_setInheritedDeadline(holderTCB, u1_t_inherit, u4_t_deadline);
+}
+#endif
+
 #endif /* Conditional compile */
 
 /***********************************************************************************************/
@@ -414,3 +614,18 @@ static void vd_OSmutex_unblockTask(OSMutex* mutex)
 /*                                if the application uses the lock/unlock functions in an      */
 /*                                incorrect sequence, or it initializes a mutex to an          */
 /*                                unintended value.                                            */
+/*                                                                                             */
+/* 0.4                10/16/26    Holder keeps inherited priority on block timeout if another  */
+/*                                blocked task shares the inherited priority (round-robin).    */
+/*                                                                                             */
+/* 0.5                10/16/26    Critical sections save interrupt mask in caller with         */
+/*                                OS_SCH_CRITICAL_ALLOC().                                     */
+/*                                                                                             */
+/* 0.6                10/16/26    Added count of mutexes held by task, used by scheduler       */
+/*                                before task delete or restart.                               */
+/*                                                                                             */
+/* 0.7                10/16/26    Under EDF, blocked list is ordered by deadline and holder    */
+/*                                inherits earliest deadline of blocked tasks.                 */
+/*                                                                                             */
+/* 0.8                10/16/26    Added blocked list re-sort and holder inheritance update     */
+/*                                when blocked task priority is changed.                       */
@@ -30,7 +30,8 @@
 ;******************************************************************************
 ;*  Routine: PendSV_Handler                                                   *
 ;*  Purpose: Perform context switch.                                          *
-;*  Registers: N/A. Pushes and restores entire context.                       *
+;*  Registers: N/A. Pushes and restores entire context. FP context only for   *
+;*             tasks that have used FPU.                                      *
 ;******************************************************************************
 PendSV_Handler PROC
                 EXPORT  PendSV_Handler            [WEAK]    
@@ -39,21 +40,45 @@ PendSV_Handler PROC
                     ;Save current task context and update task stack pointer in TCB
                     ;Note that the first entry in each TCB is its stack pointer
                     MOV     R0, SP
+                    IF {TARGET_FPU_VFP}
+                    ;EXC_RETURN bit 4 is clear only if task used FPU and HW stacked an extended frame.
+                    ;S16-S31 saved only then. S0-S15 stacked lazily by HW in space reserved in frame.
+                    ;R3 is not restored, it only pads frame to 10 words so SP stays 8-byte aligned for hook.
+                    TST     LR, #0x10
+                    IT      EQ
+                    VSTMDBEQ R0!, {S16-S31}
+                    STMDB   R0!,{R3-R11, LR}
+                    ELSE
                     STMDB   R0!,{R4-R11}                          
+                    ENDIF
                     LDR     R1, =tcb_g_p_currentTaskBlock
                     LDR     R2, [R1]
                     STR     R0, [R2]
                     
+                    ;Dispatcher hook runs on outgoing task stack below its saved context. R0-R3, R12
+                    ;were stacked by hardware and LR is reloaded below, so no registers are preserved.
+                    MOV     SP, R0
+                    BL      vd_OSsch_dispatchHook
+                    
                     ;Switch TCB pointers
+                    LDR     R1, =tcb_g_p_currentTaskBlock
                     LDR     R3, =tcb_g_p_nextTaskBlock
                     LDR     R0, [R3]                     ; safe to use R5 at this point
                     STR     R0, [R1]
                     
                     ;Pull stack pointer from new task TCB and restore context
                     LDR     R0,  [R0]
+                    IF {TARGET_FPU_VFP}
+                    LDMIA   R0!, {R3-R11, LR}
+                    TST     LR, #0x10
+                    IT      EQ
+                    VLDMIAEQ R0!, {S16-S31}
+                    MOV     SP,  R0
+                    ELSE
                     LDMIA   R0!, {R4-R11}
                     MOV     SP,  R0     
                     LDR     LR,  =0xFFFFFFF9
+                    ENDIF
                     CPSIE   I
                     
                     BX LR
@@ -104,6 +129,36 @@ WaitForInterrupt  PROC
         BX     LR
       ENDP
             
+;*********** SysTick_Handler ************************
+; System tick entry when profiler is enabled. Passes stacked exception frame and
+; EXC_RETURN to profiler so PC of interrupted code can be sampled, then branches to
+; tick ISR with LR intact. Overridden by SysTick_Handler in scheduler otherwise.
+; Tasks and kernel share MSP, so frame is at SP on entry.
+; inputs:  none
+; outputs: none
+SysTick_Handler   PROC
+        EXPORT  SysTick_Handler                [WEAK]
+        EXTERN  vd_OSprof_sample               [WEAK]
+        EXTERN  vd_OSsch_systemTick_ISR        [WEAK]
+        MOV     R0, SP
+        MOV     R1, LR
+        PUSH    {R1, LR}                       ;Two registers keep stack 8-byte aligned
+        BL      vd_OSprof_sample
+        POP     {R1, LR}
+        B       vd_OSsch_systemTick_ISR
+      ENDP
+            
+;*********** vd_OSsch_dispatchHook ************************
+; Called by PendSV_Handler between saving and restoring task context. Overridden
+; by scheduler when task run-time accounting, preemption threshold or MPU stack
+; guard is enabled.
+; inputs:  none
+; outputs: none
+vd_OSsch_dispatchHook   PROC
+        EXPORT  vd_OSsch_dispatchHook          [WEAK]
+        BX      LR
+      ENDP
+            
 ;*********** OSTaskFault ************************
 ; Scheduler reached fault condition. Condition may be stack overflow detected.
 ; inputs:  none
@@ -15,12 +15,12 @@
 typedef unsigned char  U1;
 typedef unsigned short U2;
 typedef unsigned int   U4;
-typedef unsigned long  U8;
+typedef unsigned long long U8;
 
 typedef signed char    S1;
 typedef short          S2;
 typedef int            S4;
-typedef signed long    S8;
+typedef signed long long   S8;
 
 /*************************************************************************/
 /*  Definitions                                                          */
@@ -49,6 +49,16 @@ typedef signed long    S8;
 #define NVIC_ST_CALIBRATE_R           (*((volatile U4 *)0xE000E01C))
 #define NVIC_ST_PRIORITY_R            (*((volatile U1 *)0xE000ED23))
 #define NVIC_PENDSV_PRIORITY_R        (*((volatile U1 *)0xE000ED22))
+#define CORE_DEBUG_DEMCR_R            (*((volatile U4 *)0xE000EDFC))
+#define DWT_CTRL_R                    (*((volatile U4 *)0xE0001000))
+#define DWT_CYCCNT_R                  (*((volatile U4 *)0xE0001004))
+#define FPU_FPCCR_R                   (*((volatile U4 *)0xE000EF34))
+#define SYS_REG_SHCSR_R               (*((volatile U4 *)0xE000ED24))
+#define SYS_REG_MMFSR_R               (*((volatile U1 *)0xE000ED28))
+#define SYS_REG_MMFAR_R               (*((volatile U4 *)0xE000ED34))
+#define MPU_CTRL_R                    (*((volatile U4 *)0xE000ED94))
+#define MPU_RBAR_R                    (*((volatile U4 *)0xE000ED9C))
+#define MPU_RASR_R                    (*((volatile U4 *)0xE000EDA0))
 
 
 /*************************************************************************/
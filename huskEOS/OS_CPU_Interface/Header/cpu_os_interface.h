@@ -16,9 +16,21 @@
 /*  Definitions                                                          */
 /*************************************************************************/
 #define OS_TICK_PRIORITY                       (0xC0)
+#define OS_KERNEL_INT_PRIORITY                 (RTOS_CONFIG_KERNEL_INT_PRIORITY)
 #define PENDSV_PRIORITY                        (0xE0)
 #define OS_INT_NO_MASK                         (0)
 #define CPU_PENDSV_LOAD_MASK                   (0x10000000)
+#define CPU_MMFSR_MMARVALID                    (0x80)
+#define CPU_MMFSR_STACK_GUARD_MASK             (0x3A)               /* MLSPERR, MSTKERR, MUNSTKERR, DACCVIOL. */
+
+/* FP context is switched when compiled for FPU. Task that uses FPU needs OS_CPU_FPU_FRAME_WORDS more stack. */
+#if defined(__TARGET_FPU_VFP)
+  #define OS_CPU_FPU_CONTEXT                   (RTOS_CONFIG_TRUE)
+  #define OS_CPU_FPU_FRAME_WORDS               (34)                 /* S0-S15, FPSCR, reserved stacked by HW. S16-S31 by dispatcher. */
+#else
+  #define OS_CPU_FPU_CONTEXT                   (RTOS_CONFIG_FALSE)
+  #define OS_CPU_FPU_FRAME_WORDS               (0)
+#endif
 
 /*************************************************************************/
 /*  Macros                                                               */
@@ -29,20 +41,134 @@
 /*************************************************************************/
 /*  Interface with scheduler                                             */
 /*************************************************************************/
-#define OS_CPU_ENTER_CRITICAL(void)            (vd_cpu_disableInterrupts(void))
-#define OS_CPU_EXIT_CRITICAL(void)             (vd_cpu_enableInterrupts(void)) 
+#define OS_CPU_CRITICAL_ALLOC()                U1 u1_t_criticalMask
+#define OS_CPU_ENTER_CRITICAL(void)            (u1_t_criticalMask = u1_cpu_criticalEnter(void))
+#define OS_CPU_EXIT_CRITICAL(void)             (vd_cpu_criticalExit(u1_t_criticalMask)) 
+#define OS_CPU_CRITICAL_WAIT_FOR_INTERRUPT()   (vd_cpu_criticalWaitForInterrupt(u1_t_criticalMask))
 #define vd_cpu_enableInterruptsOSStart()        EnableInterrupts(c)
 #define vd_cpu_disableInterruptsOSStart()       DisableInterrupts(c)
 #define OS_CPU_MASK_SCHEDULER_TICK(c)          (u1_cpu_maskInterrupts(OS_TICK_PRIORITY))
 #define OS_CPU_UNMASK_SCHEDULER_TICK(c)        (vd_cpu_unmaskInterrupts(c))
 #define OS_CPU_TRIGGER_DISPATCHER()            ((SYS_REG_ICSR_ADDR) |= CPU_PENDSV_LOAD_MASK)
+#define OS_CPU_COUNT_LEADING_ZEROS(c)          ((U1)__clz(c))
+#define OS_CPU_GET_CYCLE_COUNT()               (DWT_CYCCNT_R)
+#define OS_CPU_ATOMIC_INCREMENT(c)             (u4_cpu_atomicIncrement(c))
+#define OS_CPU_GET_EXCEPTION_NUMBER()          (u2_cpu_getExceptionNumber())
+#define OS_CPU_STACK_GUARD_SET(c)              (vd_cpu_stackGuardSet(c))
+#define OS_CPU_STACK_GUARD_FAULT()             ((SYS_REG_MMFSR_R & (U1)CPU_MMFSR_STACK_GUARD_MASK) != (U1)ZERO)
+#define OS_CPU_FAULT_ADDRESS()                 ((SYS_REG_MMFSR_R & (U1)CPU_MMFSR_MMARVALID) ? (void*)SYS_REG_MMFAR_R : (void*)NULL)
+#if(RTOS_CFG_OS_PROFILE_ENABLED == RTOS_CONFIG_TRUE)
+/* SysTick_Handler in taskSwitch.s passes exception frame to profiler, then branches to tick ISR. */
+#else
 #define vd_OSsch_systemTick_ISR(void)           (SysTick_Handler(void))
+#endif
+#define vd_OSsch_memFault_ISR(void)             (MemManage_Handler(void))
+#define vd_OSsch_hardFault_ISR(void)            (HardFault_Handler(void))
 
 /*************************************************************************/
 /*  Data Types                                                           */
 /*************************************************************************/
 
 
+/*************************************************************************/
+/*  Inline Functions                                                     */
+/*************************************************************************/
+/*************************************************************************/
+/*  Function Name: u1_cpu_criticalEnter                                  */
+/*  Purpose:       Enter critical section by raising BASEPRI to kernel   */
+/*                 interrupt priority. BASEPRI is only ever raised, so a */
+/*                 nested section keeps the outer mask. Previous mask is */
+/*                 kept by caller, declared with OS_CPU_CRITICAL_ALLOC().*/
+/*  Arguments:     N/A                                                   */
+/*  Return:        U1: Previous BASEPRI.                                 */
+/*************************************************************************/
+static __inline U1 u1_cpu_criticalEnter(void)
+{
+  register U4 u4_t_basepri    __asm("basepri");
+  register U4 u4_t_basepriMax __asm("basepri_max");
+  U1          u1_t_prevMask;
+  
+  u1_t_prevMask   = (U1)u4_t_basepri;
+  u4_t_basepriMax = (U4)OS_KERNEL_INT_PRIORITY;
+  __isb(0xF);
+  
+  return (u1_t_prevMask);
+}
+
+/*************************************************************************/
+/*  Function Name: vd_cpu_criticalExit                                   */
+/*  Purpose:       Exit critical section by restoring BASEPRI.           */
+/*  Arguments:     U1 prevMask:                                          */
+/*                    Value returned by u1_cpu_criticalEnter().          */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static __inline void vd_cpu_criticalExit(U1 prevMask)
+{
+  register U4 u4_t_basepri __asm("basepri");
+  
+  __schedule_barrier();
+  u4_t_basepri = (U4)prevMask;
+}
+
+/*************************************************************************/
+/*  Function Name: vd_cpu_criticalWaitForInterrupt                       */
+/*  Purpose:       Sleep until interrupt from inside critical section.   */
+/*                 WFI does not wake on interrupts masked by BASEPRI, so */
+/*                 PRIMASK holds interrupts off instead while sleeping.  */
+/*                 Interrupt that wakes CPU runs once critical section   */
+/*                 is exited.                                            */
+/*  Arguments:     U1 prevMask:                                          */
+/*                    Value returned by u1_cpu_criticalEnter().          */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static __inline void vd_cpu_criticalWaitForInterrupt(U1 prevMask)
+{
+  register U4 u4_t_basepri __asm("basepri");
+  
+  (void)__disable_irq();
+  u4_t_basepri = (U4)prevMask;
+  __dsb(0xF);
+  __wfi();
+  u4_t_basepri = (U4)OS_KERNEL_INT_PRIORITY;
+  __enable_irq();
+}
+
+/*************************************************************************/
+/*  Function Name: u4_cpu_atomicIncrement                                */
+/*  Purpose:       Increment counter without a critical section. Store   */
+/*                 is retried if an interrupt or other access occurs     */
+/*                 between load and store.                               */
+/*  Arguments:     volatile U4* counter:                                 */
+/*                    Counter to be incremented.                         */
+/*  Return:        U4: Counter value before increment.                   */
+/*************************************************************************/
+static __inline U4 u4_cpu_atomicIncrement(volatile U4* counter)
+{
+  U4 u4_t_value;
+  
+  do
+  {
+    u4_t_value = __ldrex(counter);
+  }
+  while(__strex(u4_t_value + ONE, counter));
+  
+  return (u4_t_value);
+}
+
+/*************************************************************************/
+/*  Function Name: u2_cpu_getExceptionNumber                             */
+/*  Purpose:       Read number of active exception from IPSR.            */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U2: Exception number. Zero in thread mode. IRQ n is   */
+/*                     exception n + 16.                                 */
+/*************************************************************************/
+static __inline U2 u2_cpu_getExceptionNumber(void)
+{
+  register U4 u4_t_ipsr __asm("ipsr");
+  
+  return ((U2)u4_t_ipsr);
+}
+
 /*************************************************************************/
 /*  Public Functions                                                     */
 /*************************************************************************/
@@ -63,26 +189,12 @@ void vd_cpu_init(U4 numMs);
 /*                 OS_STACK* sp:                                         */
 /*                       Pointer to bottom of task stack (highest mem.   */
 /*                       address).                                       */
+/*                 void* taskReturnFcn:                                  */
+/*                       Function entered if task routine returns.       */
 /*  Return:        os_t_p_sp:                                            */
 /*                       New stack pointer.                              */
 /*************************************************************************/
-OS_STACK* sp_cpu_taskStackInit(void (*newTaskFcn)(void), OS_STACK* sp);
-
-/*************************************************************************/
-/*  Function Name: vd_cpu_disableInterrupts                              */
-/*  Purpose:       Enter critical section by disabling interrupts.       */
-/*  Arguments:     N/A                                                   */
-/*  Return:        N/A                                                   */
-/*************************************************************************/
-void vd_cpu_disableInterrupts(void);
-
-/*************************************************************************/
-/*  Function Name: vd_cpu_enableInterrupts                               */
-/*  Purpose:       Exit critical section by enabling interrupts.         */
-/*  Arguments:     N/A                                                   */
-/*  Return:        N/A                                                   */
-/*************************************************************************/
-void vd_cpu_enableInterrupts(void);
+OS_STACK* sp_cpu_taskStackInit(void (*newTaskFcn)(void), OS_STACK* sp, void (*taskReturnFcn)(void));
 
 /*************************************************************************/
 /*  Function Name: u1_cpu_maskInterrupts                                 */
@@ -135,6 +247,38 @@ void vd_cpu_setNewSchedPeriod(U4 numMs);
 /*************************************************************************/
 U1 u1_cpu_getPercentOfTick(void);
  
+/*************************************************************************/
+/*  Function Name: u4_cpu_tickSuppress                                   */
+/*  Purpose:       Stretch SysTick period to cover multiple ticks while  */
+/*                 CPU is idle. Must be called with interrupts disabled. */
+/*  Arguments:     U4 numTicks:                                          */
+/*                    Number of ticks until next scheduled wake-up.      */
+/*  Return:        U4: Number of ticks actually programmed (capped by    */
+/*                     24-bit SysTick reload limit).                     */
+/*************************************************************************/
+U4 u4_cpu_tickSuppress(U4 numTicks);
+
+/*************************************************************************/
+/*  Function Name: u4_cpu_tickResume                                     */
+/*  Purpose:       Restore normal SysTick period after idle sleep. Must  */
+/*                 be called with interrupts disabled.                   */
+/*  Arguments:     U4 numTicks:                                          */
+/*                    Number of ticks returned by u4_cpu_tickSuppress(). */
+/*  Return:        U4: Number of whole ticks that elapsed and were not   */
+/*                     counted by the SysTick interrupt.                 */
+/*************************************************************************/
+U4 u4_cpu_tickResume(U4 numTicks);
+
+/*************************************************************************/
+/*  Function Name: vd_cpu_stackGuardSet                                  */
+/*  Purpose:       Move MPU stack guard region to limit of task stack.   */
+/*                 Called by dispatcher for task being switched in.      */
+/*  Arguments:     OS_STACK* topOfStack:                                 */
+/*                    Word at end of stack furthest from stack base.     */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_cpu_stackGuardSet(OS_STACK* topOfStack);
+ 
 /*************************************************************************/
 /*  Global Variables                                                     */
 /*************************************************************************/
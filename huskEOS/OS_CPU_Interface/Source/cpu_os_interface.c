@@ -31,12 +31,37 @@ extern void UnmaskInterrupt(U1);
 #define TIME_CAL_10_TO_1_MS           (10)
 #define SYSTICK_DISABLED              (0x00000007)
 #define SYSTICK_24_BIT_MASK           (0x00FFFFFF)
-#define INTERRUPT_NEST_COUNT_ZERO     (0)
 #define SYSTICK_CTRL_EXTERNAL_CLK     (0x03)
+#define SYSTICK_CTRL_ENABLE           (0x01)
+#define SYSTICK_CTRL_COUNTFLAG        (0x00010000)
+#define SYSTICK_CTRL_STOPPED          (SYSTICK_CTRL_EXTERNAL_CLK & ~SYSTICK_CTRL_ENABLE) /* Counter stopped, interrupt still enabled. */
+#define DEMCR_TRCENA                  (0x01000000)
+#define DWT_CTRL_CYCCNTENA            (0x00000001)
 #define STACK_FRAME_PSR_INIT          (0x01000000)
-#define END_OF_REG_STACK_FRAME        (-16)
 #define PSR_REGISTER_SLOT             (-1)
+#define LR_REGISTER_SLOT              (-2)
 #define GENERAL_PURPOSE_REG_START     (-2)
+#if(OS_CPU_FPU_CONTEXT == RTOS_CONFIG_TRUE)
+/* Initial frame, relative to top of stack: [0] xPSR, [-1] PC, [-2] LR, [-3] R12, [-4]..[-7] R3..R0 stacked by HW. */
+/* Dispatcher STMDB {R3-R11, LR} stores highest register at highest address: [-8] EXC_RETURN, [-9]..[-16] R11..R4, */
+/* [-17] R3 as padding. Frame of 10 words keeps stack 8-byte aligned when dispatcher hook is called. */
+#define END_OF_REG_STACK_FRAME        (-18)
+#define EXC_RETURN_SLOT               (-8)                /* Saved by dispatcher above R4-R11. */
+#define EXC_RETURN_THREAD_BASIC_FRAME (0xFFFFFFF9)        /* Thread mode, MSP, no FP state stacked. */
+#define FPCCR_ASPEN_LSPEN             (0xC0000000)        /* FP state stacked lazily, only if exception handler uses FPU. */
+#else
+#define END_OF_REG_STACK_FRAME        (-16)
+#endif
+#define SHCSR_MEMFAULTENA             (0x00010000)
+#define MPU_CTRL_ENABLE_PRIVDEFENA    (0x00000005)        /* Default memory map applies outside MPU regions. */
+#define MPU_GUARD_REGION              (7)                 /* Highest numbered region takes priority on overlap. */
+#define MPU_GUARD_SIZE_BYTES          (32)                /* Smallest MPU region. Base must be aligned to size. */
+#define MPU_RBAR_VALID                (0x00000010)
+#define MPU_RASR_GUARD                (0x15060009)        /* XN, privileged read-only, normal shareable cacheable, 32 bytes, enabled. Stack pushes fault, reads allowed. */
+
+#if((OS_KERNEL_INT_PRIORITY == 0) || (OS_KERNEL_INT_PRIORITY > OS_TICK_PRIORITY))
+  #error "RTOS_CONFIG_KERNEL_INT_PRIORITY MUST BE NON-ZERO AND NOT BELOW SYSTICK PRIORITY"
+#endif
 
 /*************************************************************************/
 /*  Data Types                                                           */
@@ -52,13 +77,18 @@ static clockReg reg_s_currentReloadVal;
 /*  Private Function Prototypes                                          */
 /*************************************************************************/
 static void vd_cpu_sysTickSet(U4 numMs);
+#if((RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE) || (RTOS_CONFIG_ENABLE_IDLE_JOBS == RTOS_CONFIG_TRUE) || (RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE))
+static void vd_cpu_cycleCounterInit(void);
+#endif
+#if(RTOS_CONFIG_ENABLE_MPU_STACK_GUARD == RTOS_CONFIG_TRUE)
+static void vd_cpu_mpuInit(void);
+#endif
 
 
 /*************************************************************************/
 /*  Global Variables                                                     */
 /*************************************************************************/
 static U4 u4_periodMs;
-static U1 u1_intNestCounter;
 
 /*************************************************************************/
 
@@ -72,7 +102,6 @@ static U1 u1_intNestCounter;
 void vd_cpu_init(U4 numMs)
 {
   u4_periodMs         = (U4)ZERO;
-  u1_intNestCounter   = (U1)ZERO;
   
   reg_s_currentReloadVal  = (U4)ZERO;
   SYSTICK_PRIORITY_SET_R |= (U1)OS_TICK_PRIORITY;
@@ -80,20 +109,35 @@ void vd_cpu_init(U4 numMs)
   
   vd_cpu_disableInterruptsOSStart();
   vd_cpu_sysTickSet(numMs);
+  
+#if(OS_CPU_FPU_CONTEXT == RTOS_CONFIG_TRUE)
+  FPU_FPCCR_R |= (U4)FPCCR_ASPEN_LSPEN;
+#endif
+  
+#if((RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE) || (RTOS_CONFIG_ENABLE_IDLE_JOBS == RTOS_CONFIG_TRUE) || (RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE))
+  vd_cpu_cycleCounterInit();
+#endif
+#if(RTOS_CONFIG_ENABLE_MPU_STACK_GUARD == RTOS_CONFIG_TRUE)
+  vd_cpu_mpuInit();
+#endif
 }
 
 /*************************************************************************/
 /*  Function Name: sp_cpu_taskStackInit                                  */
-/*  Purpose:       Initialize relevant parameters in task stack.         */
+/*  Purpose:       Initialize relevant parameters in task stack. Task    */
+/*                 starts with basic frame. Extended frame is used by HW */
+/*                 and dispatcher once task has executed FP instruction. */
 /*  Arguments:     void* newTaskFcn:                                     */
 /*                       Function pointer to task routine.               */
 /*                 OS_STACK* sp:                                         */
 /*                       Pointer to bottom of task stack (highest mem.   */
 /*                       address).                                       */
+/*                 void* taskReturnFcn:                                  */
+/*                       Function entered if task routine returns.       */
 /*  Return:        os_t_p_sp:                                            */
 /*                       New stack pointer.                              */
 /*************************************************************************/
-OS_STACK* sp_cpu_taskStackInit(void (*newTaskFcn)(void), OS_STACK* sp)
+OS_STACK* sp_cpu_taskStackInit(void (*newTaskFcn)(void), OS_STACK* sp, void (*taskReturnFcn)(void))
 {
   S1        s1_t_index;
   OS_STACK *os_t_p_stackFrame;
@@ -110,62 +154,17 @@ OS_STACK* sp_cpu_taskStackInit(void (*newTaskFcn)(void), OS_STACK* sp)
     os_t_p_stackFrame[s1_t_index] = (OS_STACK)ZERO;
   }
   
-   os_t_p_sp = &os_t_p_stackFrame[s1_t_index + ONE]; /* index is -16 at this point, want -15 */
+  /* Task routine returns into scheduler */
+  os_t_p_stackFrame[LR_REGISTER_SLOT] = (OS_STACK)taskReturnFcn;
   
-  return (os_t_p_sp);
-}  
-
-/*************************************************************************/
-/*  Function Name: vd_cpu_disableInterrupts                              */
-/*  Purpose:       Enter critical section by disabling interrupts.       */
-/*  Arguments:     N/A                                                   */
-/*  Return:        N/A                                                   */
-/*************************************************************************/
-#pragma push
-#pragma O0
-#pragma diag_suppress 3731 /* __ldrex and __strex instrinsics deprecated since ARMCC compiler does not guarantee the order of the load/store instructions. 
-                              The order is thus preserved by disabling optimization for this section of code and the instrinsics can be safely used. */
-void vd_cpu_disableInterrupts(void)
-{
-  U1 u1_t_newIntNestCntr;
-
-  do
-  {
-    u1_t_newIntNestCntr = __ldrex(&u1_intNestCounter);
-  }
-  while(__strex((++u1_t_newIntNestCntr), &u1_intNestCounter));
+#if(OS_CPU_FPU_CONTEXT == RTOS_CONFIG_TRUE)
+  os_t_p_stackFrame[EXC_RETURN_SLOT]  = (OS_STACK)EXC_RETURN_THREAD_BASIC_FRAME;
+#endif
   
-  DisableInterrupts();
-}
-#pragma pop
-
-/*************************************************************************/
-/*  Function Name: vd_cpu_enableInterrupts                               */
-/*  Purpose:       Exit critical section by enabling interrupts.         */
-/*  Arguments:     N/A                                                   */
-/*  Return:        N/A                                                   */
-/*************************************************************************/
-#pragma push
-#pragma O0
-#pragma diag_suppress 3731 /* __ldrex and __strex instrinsics deprecated since ARMCC compiler does not guarantee the order of the load/store instructions. 
-                              The order is thus preserved by disabling optimization for this section of code and the instrinsics can be safely used. */
-void vd_cpu_enableInterrupts(void)
-{
-  U1 u1_t_newIntNestCntr;
-
-  do
-  {
-    u1_t_newIntNestCntr = __ldrex(&u1_intNestCounter);
-  }
-  while(__strex((--u1_t_newIntNestCntr), &u1_intNestCounter));
-
+   os_t_p_sp = &os_t_p_stackFrame[s1_t_index + ONE]; /* index is END_OF_REG_STACK_FRAME at this point, want one above */
   
-  if(u1_t_newIntNestCntr == (U1)INTERRUPT_NEST_COUNT_ZERO)
-  {
-    EnableInterrupts();
-  }
-}
-#pragma pop
+  return (os_t_p_sp);
+}  
 
 /*************************************************************************/
 /*  Function Name: u1_cpu_maskInterrupts                                 */
@@ -176,15 +175,8 @@ void vd_cpu_enableInterrupts(void)
 /*************************************************************************/
 U1 u1_cpu_maskInterrupts(U1 setMask)
 {
-  U1 ut_t_interruptMask;
-  
-  vd_cpu_disableInterrupts();
-  
-  ut_t_interruptMask = MaskInterrupt(setMask);
-  
-  vd_cpu_enableInterrupts();
-  
-  return (ut_t_interruptMask);
+  /* Any interrupt taken between read and write of BASEPRI restores it before returning. */
+  return (MaskInterrupt(setMask));
 }
 
 /*************************************************************************/
@@ -196,11 +188,7 @@ U1 u1_cpu_maskInterrupts(U1 setMask)
 /*************************************************************************/
 void vd_cpu_unmaskInterrupts(U1 setMask)
 {    
-  vd_cpu_disableInterrupts();
-
   UnmaskInterrupt(setMask);
-  
-  vd_cpu_enableInterrupts();
 }
 
 /*************************************************************************/
@@ -256,6 +244,113 @@ U1 u1_cpu_getPercentOfTick(void)
   else return ((U1)ZERO);
 }
 
+/*************************************************************************/
+/*  Function Name: u4_cpu_tickSuppress                                   */
+/*  Purpose:       Stretch SysTick period to cover multiple ticks while  */
+/*                 CPU is idle. Must be called with interrupts disabled. */
+/*  Arguments:     U4 numTicks:                                          */
+/*                    Number of ticks until next scheduled wake-up.      */
+/*  Return:        U4: Number of ticks actually programmed (capped by    */
+/*                     24-bit SysTick reload limit).                     */
+/*************************************************************************/
+U4 u4_cpu_tickSuppress(U4 numTicks)
+{
+  U4 u4_t_cyclesPerTick;
+  U4 u4_t_maxTicks;
+  
+  u4_t_cyclesPerTick = reg_s_currentReloadVal + ONE;
+  u4_t_maxTicks      = (U4)SYSTICK_24_BIT_MASK/u4_t_cyclesPerTick;
+  
+  if(numTicks > u4_t_maxTicks)
+  {
+    numTicks = u4_t_maxTicks;
+  }
+  else{}
+  
+  /* Stop counter, keep remainder of current tick and add the suppressed ticks after it. */
+  SYSTICK_CONTROL_R      &= ~((U4)SYSTICK_CTRL_ENABLE);
+  SYSTICK_RELOAD_R        = (SYSTICK_24_BIT_MASK & SYSTICK_CURRENT_COUNT_R) + ((numTicks - ONE)*u4_t_cyclesPerTick);
+  SYSTICK_CURRENT_COUNT_R = CPU_FALSE;
+  SYSTICK_CONTROL_R      |= (U4)SYSTICK_CTRL_ENABLE;
+  
+  return (numTicks);
+}
+
+/*************************************************************************/
+/*  Function Name: u4_cpu_tickResume                                     */
+/*  Purpose:       Restore normal SysTick period after idle sleep. Must  */
+/*                 be called with interrupts disabled.                   */
+/*  Arguments:     U4 numTicks:                                          */
+/*                    Number of ticks returned by u4_cpu_tickSuppress(). */
+/*  Return:        U4: Number of whole ticks that elapsed and were not   */
+/*                     counted by the SysTick interrupt.                 */
+/*************************************************************************/
+U4 u4_cpu_tickResume(U4 numTicks)
+{
+  U4 u4_t_cyclesPerTick;
+  U4 u4_t_remainingCycles;
+  U4 u4_t_remainingTicks;
+  U4 u4_t_elapsedTicks;
+  
+  u4_t_cyclesPerTick  = reg_s_currentReloadVal + ONE;
+  
+  /* Reading control register clears COUNTFLAG. Counter is stopped with a plain write so the first read is the check below. */
+  SYSTICK_CONTROL_R   = (U4)SYSTICK_CTRL_STOPPED;
+  
+  if(SYSTICK_CONTROL_R & (U4)SYSTICK_CTRL_COUNTFLAG)
+  {
+    /* Whole stretched period elapsed. Pending SysTick interrupt will count the final tick. */
+    u4_t_elapsedTicks       = numTicks - ONE;
+    SYSTICK_RELOAD_R        = reg_s_currentReloadVal;
+    SYSTICK_CURRENT_COUNT_R = CPU_FALSE;
+    SYSTICK_CONTROL_R      |= (U4)SYSTICK_CTRL_ENABLE;
+  }
+  else
+  {
+    /* Woken early by another interrupt. Tick boundaries are aligned to the end of the stretched period. */
+    u4_t_remainingCycles    = SYSTICK_24_BIT_MASK & SYSTICK_CURRENT_COUNT_R;
+    u4_t_remainingTicks     = (u4_t_remainingCycles + u4_t_cyclesPerTick - ONE)/u4_t_cyclesPerTick;
+    u4_t_elapsedTicks       = numTicks - u4_t_remainingTicks;
+    
+    /* Count out the partial tick up to the next boundary. */
+    SYSTICK_RELOAD_R        = u4_t_remainingCycles - ((u4_t_remainingTicks - ONE)*u4_t_cyclesPerTick) - ONE;
+    SYSTICK_CURRENT_COUNT_R = CPU_FALSE;
+    SYSTICK_CONTROL_R      |= (U4)SYSTICK_CTRL_ENABLE;
+    
+    /* Counter has loaded remaining partial tick. Following periods use normal reload value. */
+    SYSTICK_RELOAD_R        = reg_s_currentReloadVal;
+  }
+  
+  return (u4_t_elapsedTicks);
+}
+
+/*************************************************************************/
+/*  Function Name: vd_cpu_stackGuardSet                                  */
+/*  Purpose:       Move MPU stack guard region to limit of task stack.   */
+/*                 Region is aligned inside stack, so up to              */
+/*                 MPU_GUARD_SIZE_BYTES * 2 - 4 bytes at the limit are   */
+/*                 not usable.                                           */
+/*  Arguments:     OS_STACK* topOfStack:                                 */
+/*                    Word at end of stack furthest from stack base.     */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_MPU_STACK_GUARD == RTOS_CONFIG_TRUE)
+void vd_cpu_stackGuardSet(OS_STACK* topOfStack)
+{
+  U4 u4_t_base;
+  
+#if(STACK_GROWTH == STACK_DESCENDING)
+  u4_t_base = ((U4)topOfStack + (U4)(MPU_GUARD_SIZE_BYTES - ONE)) & ~((U4)(MPU_GUARD_SIZE_BYTES - ONE));
+#elif(STACK_GROWTH == STACK_ASCENDING)
+  u4_t_base = (((U4)topOfStack + (U4)sizeof(OS_STACK)) & ~((U4)(MPU_GUARD_SIZE_BYTES - ONE))) - (U4)MPU_GUARD_SIZE_BYTES;
+#endif
+  
+  /* Region number given through RBAR so region is moved with two stores. */
+  MPU_RBAR_R = u4_t_base | (U4)MPU_RBAR_VALID | (U4)MPU_GUARD_REGION;
+  MPU_RASR_R = (U4)MPU_RASR_GUARD;
+}
+#endif
+
 /*************************************************************************/
 /*  Function Name: vd_cpu_sysTickSet                                     */
 /*  Purpose:       Configure SysTick registers.                          */
@@ -284,6 +379,40 @@ static void vd_cpu_sysTickSet(U4 numMs)
   reg_s_currentReloadVal  = numMs;
 }
 
+/*************************************************************************/
+/*  Function Name: vd_cpu_cycleCounterInit                               */
+/*  Purpose:       Enable free-running DWT cycle counter used for task   */
+/*                 run-time accounting, idle job time budget and trace   */
+/*                 timestamps.                                           */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if((RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE) || (RTOS_CONFIG_ENABLE_IDLE_JOBS == RTOS_CONFIG_TRUE) || (RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE))
+static void vd_cpu_cycleCounterInit(void)
+{
+  CORE_DEBUG_DEMCR_R |= (U4)DEMCR_TRCENA;
+  DWT_CYCCNT_R        = (U4)ZERO;
+  DWT_CTRL_R         |= (U4)DWT_CTRL_CYCCNTENA;
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_cpu_mpuInit                                        */
+/*  Purpose:       Enable MPU with default memory map as background and  */
+/*                 enable MemManage fault. Guard region is programmed    */
+/*                 when first task is dispatched.                        */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_MPU_STACK_GUARD == RTOS_CONFIG_TRUE)
+static void vd_cpu_mpuInit(void)
+{
+  SYS_REG_SHCSR_R |= (U4)SHCSR_MEMFAULTENA;
+  MPU_CTRL_R       = (U4)MPU_CTRL_ENABLE_PRIVDEFENA;
+  __dsb(0xF);
+  __isb(0xF);
+}
+#endif
 
 /***********************************************************************************************/
 /* History                                                                                     */
@@ -300,3 +429,24 @@ static void vd_cpu_sysTickSet(U4 numMs)
 /* 0.6                5/3/20      Suppressed warnings for __ldrex and strex instrinsics in     */
 /*                                ARMCC compiler V5.06.                                        */
 /*                                                                                             */
+/* 0.7                10/16/26    Added SysTick suppress/resume APIs for tickless idle.        */
+/*                                                                                             */
+/* 0.8                10/16/26    Enable DWT cycle counter for task run-time accounting.       */
+/*                                                                                             */
+/* 0.9                10/16/26    Task stack frame LR set to scheduler return handler.         */
+/*                                                                                             */
+/* 1.0                10/16/26    Cycle counter also enabled for idle job time budget.         */
+/*                                                                                             */
+/* 1.1                10/16/26    Critical sections raise BASEPRI to kernel interrupt priority */
+/*                                and save previous mask in caller. Nesting counter removed.   */
+/*                                                                                             */
+/* 1.2                10/16/26    Stack frame holds EXC_RETURN when compiled for FPU. FP       */
+/*                                context of tasks that use FPU is switched by dispatcher.     */
+/*                                                                                             */
+/* 1.3                10/16/26    Added MPU init and stack guard region programming.           */
+/*                                                                                             */
+/* 1.4                10/16/26    Cycle counter enabled for trace timestamps.                  */
+/*                                                                                             */
+/* 1.5                10/16/26    Initial stack frame padded to match dispatcher FPU build     */
+/*                                frame, which is padded to 8 bytes.                           */
+/*                                                                                             */
@@ -0,0 +1,84 @@
+/*************************************************************************/
+/*  File Name:  prof.h                                                   */
+/*  Purpose:    Header file for statistical PC-sampling profiler.        */
+/*  Created by: Garrett Sculthorpe on 10/16/26                           */
+/*  Copyright © 2019 Garrett Sculthorpe and Darren Cicala.               */
+/*              All rights reserved.                                     */
+/*************************************************************************/
+
+#ifndef prof_h
+#if(RTOS_CFG_OS_PROFILE_ENABLED == RTOS_CONFIG_TRUE)
+#define prof_h
+
+#include "rtos_cfg.h"
+
+/*************************************************************************/
+/*  Definitions                                                          */
+/*************************************************************************/
+#define PROF_TASK_ID_ISR               (0xFE)   /* Sample taken while another interrupt was running.  */
+#define PROF_TASK_ID_NONE              (0xFF)   /* Sample taken before first task was started.         */
+
+/*************************************************************************/
+/*  Data Types                                                           */
+/*************************************************************************/
+typedef struct OSProfSample
+{
+  U4 pc;                             /* Address of interrupted instruction. */
+  U4 count;                          /* Number of samples at this PC and task. */
+  U1 taskID;
+  U1 reserved[3];
+}
+OSProfSample;
+
+/*************************************************************************/
+/*  Public Functions                                                     */
+/*************************************************************************/
+/*************************************************************************/
+/*  Function Name: u4_OSprof_read                                        */
+/*  Purpose:       Copy histogram bins that hold samples. Bins are 12    */
+/*                 bytes, little-endian, and may be written as-is to a   */
+/*                 file for Tools/prof_symbolize.py.                     */
+/*  Arguments:     OSProfSample* samples:                                */
+/*                    Destination array.                                 */
+/*                 U4 maxSamples:                                        */
+/*                    Number of bins destination can hold.               */
+/*  Return:        U4: Number of bins copied.                            */
+/*************************************************************************/
+U4 u4_OSprof_read(OSProfSample* samples, U4 maxSamples);
+
+/*************************************************************************/
+/*  Function Name: vd_OSprof_reset                                       */
+/*  Purpose:       Clear histogram and sample counts.                    */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSprof_reset(void);
+
+/*************************************************************************/
+/*  Function Name: u4_OSprof_getNumSamples                               */
+/*  Purpose:       Get number of samples taken since init or reset,      */
+/*                 including dropped samples.                            */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U4: Number of samples.                                */
+/*************************************************************************/
+U4 u4_OSprof_getNumSamples(void);
+
+/*************************************************************************/
+/*  Function Name: u4_OSprof_getNumDropped                               */
+/*  Purpose:       Get number of samples not binned because no free bin  */
+/*                 was found near their hash. A high count means table  */
+/*                 size should be increased.                             */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U4: Number of dropped samples.                        */
+/*************************************************************************/
+U4 u4_OSprof_getNumDropped(void);
+
+/*************************************************************************/
+/*  Global Variables                                                     */
+/*************************************************************************/
+
+#else
+#warning "PROFILE MODULE NOT ENABLED"
+
+#endif /* Conditional compile */
+#endif
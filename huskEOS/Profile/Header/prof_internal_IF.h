@@ -0,0 +1,43 @@
+/*************************************************************************/
+/*  File Name:  prof_internal_IF.h                                       */
+/*  Purpose:    Kernel access routines for profiler.                     */
+/*  Created by: Garrett Sculthorpe on 10/16/26                           */
+/*  Copyright © 2019 Garrett Sculthorpe and Darren Cicala.               */
+/*              All rights reserved.                                     */
+/*************************************************************************/
+
+#ifndef prof_internal_IF_h
+#define prof_internal_IF_h
+
+#include "rtos_cfg.h"
+
+/*************************************************************************/
+/*  Public Functions                                                     */
+/*************************************************************************/
+
+/*************************************************************************/
+/*  Function Name: vd_OSprof_init                                        */
+/*  Purpose:       Initialize profiler. Called by vd_OS_init().          */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSprof_init(void);
+
+/*************************************************************************/
+/*  Function Name: vd_OSprof_sample                                      */
+/*  Purpose:       Bin PC of interrupted code. Called by SysTick_Handler */
+/*                 in taskSwitch.s before system tick ISR.               */
+/*  Arguments:     U4* frame:                                            */
+/*                    Exception frame stacked on tick entry.             */
+/*                 U4 excReturn:                                         */
+/*                    EXC_RETURN value of tick exception.                */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSprof_sample(U4* frame, U4 excReturn);
+
+/*************************************************************************/
+/*  Global Variables                                                     */
+/*************************************************************************/
+
+
+#endif
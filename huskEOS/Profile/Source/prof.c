@@ -0,0 +1,242 @@
+/*************************************************************************/
+/*  File Name: prof.c                                                    */
+/*  Purpose: Statistical profiler. PC of interrupted code sampled on     */
+/*           system tick and binned by PC and task ID. Bins mapped to    */
+/*           symbols on host by Tools/prof_symbolize.py.                 */
+/*  Created by: Garrett Sculthorpe on 10/16/26.                          */
+/*  Copyright © 2019 Garrett Sculthorpe and Darren Cicala.               */
+/*              All rights reserved.                                     */
+/*************************************************************************/
+
+#include "rtos_cfg.h"
+
+#if(RTOS_CFG_OS_PROFILE_ENABLED == RTOS_CONFIG_TRUE)
+
+/*************************************************************************/
+/*  Includes                                                             */
+/*************************************************************************/
+#include "prof_internal_IF.h"
+#include "prof.h"
+#include "sch_internal_IF.h"
+#include "sch.h"
+
+/*************************************************************************/
+/*  Definitions                                                          */
+/*************************************************************************/
+#define PROF_TABLE_SIZE                (RTOS_CFG_PROFILE_TABLE_SIZE)
+#define PROF_INDEX_MASK                (PROF_TABLE_SIZE - 1)
+#define PROF_TICK_DIVIDER              (RTOS_CFG_PROFILE_TICK_DIVIDER)
+#define PROF_MAX_PROBES                (8)                        /* Bounds time spent in tick interrupt when table is crowded. */
+#define PROF_FRAME_PC_INDEX            (6)                        /* R0-R3, R12, LR, PC, xPSR. Same for extended FP frame. */
+#define PROF_EXC_RETURN_THREAD_MASK    (0x08)                     /* EXC_RETURN bit 3 set when returning to thread mode. */
+
+#if((PROF_TABLE_SIZE == 0) || ((PROF_TABLE_SIZE & PROF_INDEX_MASK) != 0))
+  #error "RTOS_CFG_PROFILE_TABLE_SIZE MUST BE A POWER OF TWO"
+#endif
+
+#if(PROF_TICK_DIVIDER == 0)
+  #error "RTOS_CFG_PROFILE_TICK_DIVIDER MUST BE AT LEAST 1"
+#endif
+
+/*************************************************************************/
+/*  Static Global Variables, Constants                                   */
+/*************************************************************************/
+static OSProfSample Prof_s_as_table[PROF_TABLE_SIZE];
+static U4           u4_s_tickDivider;
+static U4           u4_s_numSamples;
+static U4           u4_s_numDropped;
+
+/*************************************************************************/
+/*  Private Function Prototypes                                          */
+/*************************************************************************/
+static void vd_prof_clear(void);
+
+/*************************************************************************/
+
+/*************************************************************************/
+/*  Function Name: vd_OSprof_init                                        */
+/*  Purpose:       Initialize profiler. Called by vd_OS_init().          */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSprof_init(void)
+{
+  vd_prof_clear();
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSprof_sample                                      */
+/*  Purpose:       Bin PC of interrupted code. Called by SysTick_Handler */
+/*                 in taskSwitch.s before system tick ISR. Runs at tick  */
+/*                 priority, so it is the only writer of the table.      */
+/*  Arguments:     U4* frame:                                            */
+/*                    Exception frame stacked on tick entry.             */
+/*                 U4 excReturn:                                         */
+/*                    EXC_RETURN value of tick exception.                */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSprof_sample(U4* frame, U4 excReturn)
+{
+  U4 u4_t_pc;
+  U4 u4_t_index;
+  U1 u1_t_taskID;
+  U1 u1_t_probe;
+
+  if(++u4_s_tickDivider >= (U4)PROF_TICK_DIVIDER)
+  {
+    u4_s_tickDivider = (U4)ZERO;
+    ++u4_s_numSamples;
+
+    u4_t_pc = frame[PROF_FRAME_PC_INDEX];
+
+    /* Tick that preempted another interrupt is not charged to the task below it. */
+    if((excReturn & (U4)PROF_EXC_RETURN_THREAD_MASK) == (U4)ZERO)
+    {
+      u1_t_taskID = (U1)PROF_TASK_ID_ISR;
+    }
+    else if(tcb_g_p_currentTaskBlock == (Sch_Task*)NULL)
+    {
+      u1_t_taskID = (U1)PROF_TASK_ID_NONE;
+    }
+    else
+    {
+      u1_t_taskID = tcb_g_p_currentTaskBlock->taskID;
+    }
+
+    /* Thumb instructions are halfword aligned. Bit 0 of PC is always clear. */
+    u4_t_index = ((u4_t_pc >> 1) ^ (u4_t_pc >> 9) ^ (U4)u1_t_taskID) & (U4)PROF_INDEX_MASK;
+
+    /* Linear probe. Bin is claimed by first sample to hash near it. */
+    for(u1_t_probe = (U1)ZERO; u1_t_probe < (U1)PROF_MAX_PROBES; u1_t_probe++)
+    {
+      if(Prof_s_as_table[u4_t_index].count == (U4)ZERO)
+      {
+        Prof_s_as_table[u4_t_index].pc     = u4_t_pc;
+        Prof_s_as_table[u4_t_index].taskID = u1_t_taskID;
+        break;
+      }
+      else if((Prof_s_as_table[u4_t_index].pc == u4_t_pc) && (Prof_s_as_table[u4_t_index].taskID == u1_t_taskID))
+      {
+        break;
+      }
+      else{}
+
+      u4_t_index = (u4_t_index + ONE) & (U4)PROF_INDEX_MASK;
+    }
+
+    if(u1_t_probe < (U1)PROF_MAX_PROBES)
+    {
+      ++Prof_s_as_table[u4_t_index].count;
+    }
+    else
+    {
+      ++u4_s_numDropped;
+    }
+  }
+  else{}
+}
+
+/*************************************************************************/
+/*  Function Name: u4_OSprof_read                                        */
+/*  Purpose:       Copy histogram bins that hold samples.                */
+/*  Arguments:     OSProfSample* samples:                                */
+/*                    Destination array.                                 */
+/*                 U4 maxSamples:                                        */
+/*                    Number of bins destination can hold.               */
+/*  Return:        U4: Number of bins copied.                            */
+/*************************************************************************/
+U4 u4_OSprof_read(OSProfSample* samples, U4 maxSamples)
+{
+  U4 u4_t_index;
+  U4 u4_t_count;
+
+  OS_SCH_CRITICAL_ALLOC();
+
+  u4_t_count = (U4)ZERO;
+
+  /* One bin per critical section so tick latency does not grow with table size. */
+  for(u4_t_index = (U4)ZERO; (u4_t_index < (U4)PROF_TABLE_SIZE) && (u4_t_count < maxSamples); u4_t_index++)
+  {
+    OS_SCH_ENTER_CRITICAL();
+
+    if(Prof_s_as_table[u4_t_index].count != (U4)ZERO)
+    {
+      samples[u4_t_count] = Prof_s_as_table[u4_t_index];
+      ++u4_t_count;
+    }
+    else{}
+
+    OS_SCH_EXIT_CRITICAL();
+  }
+
+  return (u4_t_count);
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSprof_reset                                       */
+/*  Purpose:       Clear histogram and sample counts.                    */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSprof_reset(void)
+{
+  OS_SCH_CRITICAL_ALLOC();
+
+  OS_SCH_ENTER_CRITICAL();
+
+  vd_prof_clear();
+
+  OS_SCH_EXIT_CRITICAL();
+}
+
+/*************************************************************************/
+/*  Function Name: u4_OSprof_getNumSamples                               */
+/*  Purpose:       Get number of samples taken since init or reset.      */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U4: Number of samples.                                */
+/*************************************************************************/
+U4 u4_OSprof_getNumSamples(void)
+{
+  return (u4_s_numSamples);
+}
+
+/*************************************************************************/
+/*  Function Name: u4_OSprof_getNumDropped                               */
+/*  Purpose:       Get number of samples not binned.                     */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U4: Number of dropped samples.                        */
+/*************************************************************************/
+U4 u4_OSprof_getNumDropped(void)
+{
+  return (u4_s_numDropped);
+}
+
+/*************************************************************************/
+/*  Function Name: vd_prof_clear                                         */
+/*  Purpose:       Zero all bins and counters.                           */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_prof_clear(void)
+{
+  U4 u4_t_index;
+
+  for(u4_t_index = (U4)ZERO; u4_t_index < (U4)PROF_TABLE_SIZE; u4_t_index++)
+  {
+    Prof_s_as_table[u4_t_index].count = (U4)ZERO;
+  }
+
+  u4_s_tickDivider = (U4)ZERO;
+  u4_s_numSamples  = (U4)ZERO;
+  u4_s_numDropped  = (U4)ZERO;
+}
+
+#endif /* Conditional compile */
+
+/***********************************************************************************************/
+/* History                                                                                     */
+/***********************************************************************************************/
+/* Version            Date        Description                                                  */
+/*                                                                                             */
+/* 0.1                10/16/26    Module implemented.                                          */
+/*                                                                                             */
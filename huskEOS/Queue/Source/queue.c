@@ -22,6 +22,11 @@
 #include "sch_internal_IF.h"
 #include "sch.h"
 
+#if(RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE)
+#include "trace_internal_IF.h"
+#include "trace.h"
+#endif
+
 /*************************************************************************/
 /*  Definitions                                                          */
 /*************************************************************************/
@@ -62,6 +67,7 @@ U1 u1_OSqueue_init(Q_MEM* queueStart, U4 queueLength)
          U1 u1_t_index;
          U1 u1_t_return;
   static U1 u1_s_numQueuesAllocated = (U1)ZERO;
+  OS_SCH_CRITICAL_ALLOC();
   
   /* Check that there is available overhead for new queue. */
   if(u1_s_numQueuesAllocated < (U1)FIFO_MAX_NUM_QUEUES)
@@ -109,6 +115,7 @@ U1 u1_OSqueue_init(Q_MEM* queueStart, U4 queueLength)
 U1 u1_OSqueue_flushFifo(U1 queueNum, U1* error)
 {
   U1 u1_t_return;
+  OS_SCH_CRITICAL_ALLOC();
   
   *error = u1_queue_checkValidFIFO(queueNum);
   
@@ -154,6 +161,7 @@ Q_MEM data_OSqueue_get(U1 queueNum, U4 blockPeriod, U1* error)
 {
   Q_MEM* data_t_p_nextGetPtr;
   Q_MEM  data_t_return;
+  OS_SCH_CRITICAL_ALLOC();
   
   *error = u1_queue_checkValidFIFO(queueNum);
   
@@ -246,6 +254,14 @@ Q_MEM data_OSqueue_get(U1 queueNum, U4 blockPeriod, U1* error)
       }
     }/* data_t_p_nextGetPtr == queue_queueList[queueNum].putPtr */
     
+#if(RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE)
+    if(*error == (U1)FIFO_ERR_NO_ERROR)
+    {
+      vd_OStrace_record((U1)TRACE_EVT_QUEUE_GET, tcb_g_p_currentTaskBlock->taskID, queueNum);
+    }
+    else{}
+#endif
+    
     OS_SCH_EXIT_CRITICAL();
     
   }/* if(*error)  */
@@ -269,6 +285,7 @@ U1 u1_OSqueue_getSts(U1 queueNum, U1* error)
 {
   U1     u1_t_sts;
   Q_MEM* Q_MEM_t_p_nextGetPtr;
+  OS_SCH_CRITICAL_ALLOC();
   
   *error = u1_queue_checkValidFIFO(queueNum);
   
@@ -327,6 +344,7 @@ U1 u1_OSqueue_getSts(U1 queueNum, U1* error)
 U1 u1_OSqueue_put(U1 queueNum, U4 blockPeriod, Q_MEM message, U1* error)
 {
   U1 u1_t_return;
+  OS_SCH_CRITICAL_ALLOC();
   
   *error = u1_queue_checkValidFIFO(queueNum);
   
@@ -416,6 +434,14 @@ U1 u1_OSqueue_put(U1 queueNum, U4 blockPeriod, Q_MEM message, U1* error)
       }
     }/* queue_queueList[queueNum].putPtr == (queue_queueList[queueNum].getPtr) */
     
+#if(RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE)
+    if(*error == (U1)FIFO_ERR_NO_ERROR)
+    {
+      vd_OStrace_record((U1)TRACE_EVT_QUEUE_PUT, tcb_g_p_currentTaskBlock->taskID, queueNum);
+    }
+    else{}
+#endif
+    
     OS_SCH_EXIT_CRITICAL();
     
   }/* if(*error) */
@@ -437,6 +463,7 @@ U1 u1_OSqueue_put(U1 queueNum, U4 blockPeriod, Q_MEM message, U1* error)
 U4 u4_OSqueue_getNumInFIFO(U1 queueNum, U1* error)
 {
   U4 u4_t_count;
+  OS_SCH_CRITICAL_ALLOC();
   
   *error = u1_queue_checkValidFIFO(queueNum);
   
@@ -477,6 +504,7 @@ U4 u4_OSqueue_getNumInFIFO(U1 queueNum, U1* error)
 void vd_OSqueue_blockedTaskTimeout(Queue* queueAddr, struct Sch_Task* taskTCB)
 {
   ListNode* node_t_tempPtr;
+  OS_SCH_CRITICAL_ALLOC();
   
   OS_SCH_ENTER_CRITICAL();
   
@@ -573,3 +601,8 @@ static void vd_queue_unblockWaitingTasks(U1 queueNum)
 /*                                                                                             */
 /* 1.2                5/12/20     u1_OSqueue_flushFifo() will no longer reset queue entries to */
 /*                                zero as this is unnecessary.                                 */
+/*                                                                                             */
+/* 1.3                10/16/26    Critical sections save interrupt mask in caller with         */
+/*                                OS_SCH_CRITICAL_ALLOC().                                     */
+/*                                                                                             */
+/* 1.4                10/16/26    Queue put/get trace events recorded.                         */
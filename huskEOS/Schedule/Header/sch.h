@@ -17,6 +17,47 @@
 #define SCH_TASK_CREATE_SUCCESS                  (1)
 #define SCH_TASK_CREATE_DENIED                   (0)
 #define SCH_BG_TASK_STACK_SIZE                   (RTOS_CONFIG_BG_TASK_STACK_SIZE) 
+#define SCH_FPU_STACK_WORDS                      (OS_CPU_FPU_FRAME_WORDS)            /* Extra stack needed by task that uses FPU. */
+#define SCH_SET_DEADLINE_SUCCESS                 (1)
+#define SCH_SET_DEADLINE_DENIED                  (0)
+#define SCH_SET_THRESHOLD_SUCCESS                (1)
+#define SCH_SET_THRESHOLD_DENIED                 (0)
+#define SCH_PERIODIC_NOT_PERIODIC                (0)
+#define SCH_PERIODIC_ON_TIME                     (1)
+#define SCH_PERIODIC_OVERRUN                     (2)
+#define SCH_PERIODIC_STATS_SUCCESS               (1)
+#define SCH_PERIODIC_STATS_DENIED                (0)
+#define SCH_PARTITION_SUCCESS                    (1)
+#define SCH_PARTITION_DENIED                     (0)
+#define SCH_PARTITION_MAJOR_FRAME                (RTOS_CONFIG_PARTITION_MAJOR_FRAME)
+#define SCH_TABLE_START_SUCCESS                  (1)
+#define SCH_TABLE_START_DENIED                   (0)
+#define SCH_TASK_DELETE_SUCCESS                  (1)
+#define SCH_TASK_DELETE_DENIED                   (0)
+#define SCH_TASK_RESTART_SUCCESS                 (1)
+#define SCH_TASK_RESTART_DENIED                  (0)
+#define SCH_SET_PRIORITY_SUCCESS                 (1)
+#define SCH_SET_PRIORITY_DENIED                  (0)
+#define SCH_PRIO_TRACE_APPLICATION               (0)                /* Priority changed by u1_OSsch_setTaskPriority(). */
+#define SCH_PRIO_TRACE_INHERITANCE               (1)                /* Priority raised or restored by mutex priority inheritance. */
+#define SCH_IDLE_JOB_DONE                        (0)                /* Returned by job step function when job is complete. */
+#define SCH_IDLE_JOB_MORE                        (1)                /* Returned by job step function when more steps are needed. */
+#define SCH_IDLE_JOB_POST_SUCCESS                (1)
+#define SCH_IDLE_JOB_POST_DENIED                 (0)
+#define SCH_SLEEP_STATE_SUCCESS                  (1)
+#define SCH_SLEEP_STATE_DENIED                   (0)
+#define SCH_SLEEP_STATE_NONE                     (0xFF)             /* No registered state chosen. Plain wait-for-interrupt is used. */
+#define SCH_WAKE_BATCH_NUM_WORDS                 ((RTOS_CONFIG_MAX_NUM_TASKS + 31) >> 5)
+#define SCH_NOTIFY_SUCCESS                       (1)
+#define SCH_NOTIFY_DENIED                        (0)
+#define SCH_NOTIFY_RECEIVED                      (1)
+#define SCH_NOTIFY_TIMEOUT                       (0)
+#define SCH_NOTIFY_GIVE                          (0)                /* Notification value unchanged. */
+#define SCH_NOTIFY_SET_BITS                      (1)                /* Value OR'd into notification value. */
+#define SCH_NOTIFY_INCREMENT                     (2)                /* Notification value incremented. */
+#define SCH_NOTIFY_OVERWRITE                     (3)                /* Notification value replaced. */
+#define SCH_NOTIFY_NO_BLOCK                      (0)
+#define SCH_NOTIFY_WAIT_FOREVER                  (MAX_VAL_4BYTE)
 
 /* Task wakeup reasons  */
 #define SCH_TASK_WAKEUP_SLEEP_TIMEOUT            (0x00)
@@ -26,10 +67,22 @@
 #define SCH_TASK_WAKEUP_SEMA_READY               (0x03)
 #define SCH_TASK_WAKEUP_FLAGS_EVENT              (0x04)
 #define SCH_TASK_WAKEUP_MUTEX_READY              (0x05)
+#define SCH_TASK_WAKEUP_NOTIFY                   (0x06)
+
+/*************************************************************************/
+/*  Function Name: OS_SCH_CRITICAL_ALLOC                                 */
+/*  Purpose:       Declare storage for interrupt mask saved by critical  */
+/*                 section. Must be in declarations of each function     */
+/*                 that uses OS_SCH_ENTER_CRITICAL().                    */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#define OS_SCH_CRITICAL_ALLOC()                  OS_CPU_CRITICAL_ALLOC()
 
 /*************************************************************************/
 /*  Function Name: OS_SCH_ENTER_CRITICAL                                 */
-/*  Purpose:       Critical section enter. Supports nesting.             */
+/*  Purpose:       Critical section enter. Supports nesting. Interrupts  */
+/*                 above RTOS_CONFIG_KERNEL_INT_PRIORITY are not masked. */
 /*  Arguments:     N/A                                                   */
 /*  Return:        N/A                                                   */
 /*************************************************************************/
@@ -59,10 +112,97 @@
 /*************************************************************************/
 #define vd_OSsch_unmaskInterrupts(c)             (OS_CPU_UNMASK_SCHEDULER_TICK(c))
 
+/*************************************************************************/
+/*  Function Name: u1_OSsch_tickIsBefore                                 */
+/*  Purpose:       Wrap-safe compare of two tick values. Valid while     */
+/*                 values are less than 2^31 ticks apart.                */
+/*  Arguments:     U4 a, b:                                              */
+/*                    Tick values, e.g. from u4_OSsch_getTicks().        */
+/*  Return:        Non-zero if tick a is before tick b.                  */
+/*************************************************************************/
+#define u1_OSsch_tickIsBefore(a, b)              ((U1)((S4)((U4)(a) - (U4)(b)) < (S4)ZERO))
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_tickIsAfter                                  */
+/*  Purpose:       Wrap-safe compare of two tick values. Valid while     */
+/*                 values are less than 2^31 ticks apart.                */
+/*  Arguments:     U4 a, b:                                              */
+/*                    Tick values, e.g. from u4_OSsch_getTicks().        */
+/*  Return:        Non-zero if tick a is after tick b.                   */
+/*************************************************************************/
+#define u1_OSsch_tickIsAfter(a, b)               ((U1)((S4)((U4)(a) - (U4)(b)) > (S4)ZERO))
+
   
 /*************************************************************************/
 /*  Data Types                                                           */
 /*************************************************************************/
+/* Timing statistics of a periodic task. All times in scheduler ticks. */
+typedef struct OSPeriodicStats
+{
+  U4 releases;         /* Number of jobs started. */
+  U4 maxJitter;        /* Longest delay from release to job start. */
+  U4 maxResponse;      /* Longest delay from release to job completion. */
+  U4 avgResponse;      /* Average delay from release to job completion. */
+  U4 overruns;         /* Jobs that completed at or after the next release. */
+  U4 deadlineMisses;   /* Jobs that completed after their deadline tick. */
+}
+OSPeriodicStats;
+
+/* State of a partition. Times in scheduler ticks. */
+typedef struct OSPartitionInfo
+{
+  const char* name;           /* Name given when partition was created. */
+  U4          budget;         /* Ticks partition may run per major frame. */
+  U4          remaining;      /* Ticks left in current major frame. */
+  U4          exhaustCount;   /* Number of major frames in which budget ran out. */
+}
+OSPartitionInfo;
+
+/* Schedule table entry. Task is released when hyperperiod reaches offset. */
+typedef struct OSScheduleEntry
+{
+  U4 offset;                  /* Tick within hyperperiod. */
+  U1 taskID;                  /* Task to release. */
+}
+OSScheduleEntry;
+
+/* Record of one task priority change. */
+typedef struct OSPriorityTraceEntry
+{
+  U4 tick;                    /* Scheduler tick of change. */
+  U1 taskID;
+  U1 oldPriority;
+  U1 newPriority;
+  U1 cause;                   /* SCH_PRIO_TRACE_APPLICATION or SCH_PRIO_TRACE_INHERITANCE. */
+}
+OSPriorityTraceEntry;
+
+/* Idle governor statistics of one sleep state. */
+typedef struct OSSleepStateStats
+{
+  U4 entries;                 /* Number of times state was chosen. */
+  U8 residencyTicks;          /* Total ticks spent idle in state. */
+  U4 tooDeep;                 /* Idle ended within state latency. */
+  U4 tooShallow;              /* Idle was long enough for a state of lower power cost. */
+}
+OSSleepStateStats;
+
+/* Job run by background task. Storage owned by application, contents managed by scheduler. */
+typedef struct OSIdleJob
+{
+  U1              (*step)(void* arg); /* Does one short, bounded piece of work. */
+  void*             arg;              /* Passed to step function. */
+  struct OSIdleJob* next;             /* Next job in queue. */
+  U1                queued;           /* Job is in queue. */
+}
+OSIdleJob;
+
+/* Set of tasks to be woken together. Bit set (MSB first) for each task ID. */
+typedef struct OSWakeBatch
+{
+  U4 taskMap[SCH_WAKE_BATCH_NUM_WORDS];
+}
+OSWakeBatch;
 
 
 /*************************************************************************/
@@ -90,7 +230,9 @@ void vd_OS_init(U4 numMsPeriod);
 /*                 U4 sizeOfStack:                                       */
 /*                       Size of task stack.                             */
 /*                 U1 priority:                                          */
-/*                       Unique priority level for task. 0 = highest.    */
+/*                       Priority level for task. 0 = highest, 0xEF =    */
+/*                       lowest. Must be unique unless round-robin is    */
+/*                       enabled.                                        */
 /*                 U1 taskID:                                            */
 /*                       Task ID to refer to task when using APIs (cannot*/
 /*                       be changed). Value must be between 0 and the    */
@@ -101,6 +243,210 @@ void vd_OS_init(U4 numMsPeriod);
 /*************************************************************************/
 U1 u1_OSsch_createTask(void (*newTaskFcn)(void), void* sp, U4 sizeOfStack, U1 priority, U1 taskID);
 
+/*************************************************************************/
+/*  Function Name: u1_OSsch_createSharedStackTask                        */
+/*  Purpose:       Create run-to-completion task on a stack that may be  */
+/*                 shared with other tasks. Task is created suspended.   */
+/*                 Each vd_OSsch_taskWake() runs task function from its  */
+/*                 start until it returns. Task must not block before it */
+/*                 returns. Tasks may only share a stack if none of them */
+/*                 can preempt another (priority of each is not above    */
+/*                 preemption threshold of the others).                  */
+/*  Arguments:     void* newTaskFcn:                                     */
+/*                       Function pointer to task routine.               */
+/*                 void* sp:                                             */
+/*                       Pointer to bottom of shared stack (highest mem. */
+/*                       address).                                       */
+/*                 U4 sizeOfStack:                                       */
+/*                       Size of shared stack.                           */
+/*                 U1 priority:                                          */
+/*                       Priority level for task. 0 = highest, 0xEF =    */
+/*                       lowest.                                         */
+/*                 U1 preemptThreshold:                                  */
+/*                       Only tasks of higher priority than this value   */
+/*                       may preempt task. Must not be below priority.   */
+/*                 U1 taskID:                                            */
+/*                       Task ID to refer to task when using APIs.       */
+/*                                                                       */
+/*  Return:        SCH_TASK_CREATE_SUCCESS   OR                          */
+/*                 SCH_TASK_CREATE_DENIED                                */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_createSharedStackTask(void (*newTaskFcn)(void), void* sp, U4 sizeOfStack, U1 priority, U1 preemptThreshold, U1 taskID);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_createPeriodicTask                           */
+/*  Purpose:       Create task that is released by the kernel every      */
+/*                 period. Task routine loops on                         */
+/*                 u1_OSsch_taskWaitNextPeriod(), which blocks until the */
+/*                 next release. Releases are at fixed absolute ticks so */
+/*                 they do not drift with task execution time.           */
+/*  Arguments:     void* newTaskFcn, void* sp, U4 sizeOfStack,           */
+/*                 U1 priority, U1 taskID:                               */
+/*                       Same as u1_OSsch_createTask().                  */
+/*                 U4 period:                                            */
+/*                       Release period in ticks. Must not be zero.      */
+/*                 U4 phase:                                             */
+/*                       Ticks from creation to first release.           */
+/*                 U4 relativeDeadline:                                  */
+/*                       Deadline in ticks after each release. If zero,  */
+/*                       deadline is equal to period. Must not be above  */
+/*                       period.                                         */
+/*                                                                       */
+/*  Return:        SCH_TASK_CREATE_SUCCESS   OR                          */
+/*                 SCH_TASK_CREATE_DENIED                                */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PERIODIC_TASKS == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_createPeriodicTask(void (*newTaskFcn)(void), void* sp, U4 sizeOfStack, U1 priority, U1 taskID, U4 period, U4 phase, U4 relativeDeadline);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_setPreemptThreshold                          */
+/*  Purpose:       Set preemption threshold of task. Once task runs it   */
+/*                 can only be preempted by tasks with a higher priority */
+/*                 than its threshold. Takes effect next time task is    */
+/*                 dispatched.                                           */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*                 U1 preemptThreshold:                                  */
+/*                    Threshold priority. Must not be below priority of  */
+/*                    task. Equal to priority for normal preemption.     */
+/*  Return:        SCH_SET_THRESHOLD_SUCCESS   OR                        */
+/*                 SCH_SET_THRESHOLD_DENIED                              */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_setPreemptThreshold(U1 taskID, U1 preemptThreshold);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_setTaskDeadline                              */
+/*  Purpose:       Set EDF timing parameters of task and start a new job */
+/*                 of task now. Absolute deadline is computed again each */
+/*                 time task wakes after it finished its job by sleeping */
+/*                 or suspending itself. Resource and notify wakes keep  */
+/*                 the deadline of the current job.                      */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*                 U4 relativeDeadline:                                  */
+/*                    Deadline in ticks after each release. If zero,     */
+/*                    deadline is equal to period.                       */
+/*                 U4 period:                                            */
+/*                    Minimum time between releases in ticks. Task woken */
+/*                    earlier is given deadline of its earliest allowed  */
+/*                    release. Zero if aperiodic. If both values are     */
+/*                    zero, task has no deadline and is scheduled by     */
+/*                    priority after all deadline tasks.                 */
+/*  Return:        SCH_SET_DEADLINE_SUCCESS   OR                         */
+/*                 SCH_SET_DEADLINE_DENIED                               */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_setTaskDeadline(U1 taskID, U4 relativeDeadline, U4 period);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_partitionCreate                              */
+/*  Purpose:       Create partition with a CPU budget per major frame.   */
+/*                 Once budget is used up, ready tasks of the partition  */
+/*                 are suspended until budget is replenished at the start*/
+/*                 of the next major frame. Tasks of the partition woken */
+/*                 in the meantime also wait for replenish.              */
+/*  Arguments:     U1 partitionID:                                       */
+/*                    0 to RTOS_CONFIG_NUM_PARTITIONS - 1.               */
+/*                 const char* name:                                     */
+/*                    Name for debug. May be NULL.                       */
+/*                 U4 budget:                                            */
+/*                    Ticks per major frame. 1 to                        */
+/*                    SCH_PARTITION_MAJOR_FRAME.                         */
+/*  Return:        SCH_PARTITION_SUCCESS   OR                            */
+/*                 SCH_PARTITION_DENIED                                  */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_partitionCreate(U1 partitionID, const char* name, U4 budget);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_partitionAddTask                             */
+/*  Purpose:       Move task into a partition.                           */
+/*  Arguments:     U1 partitionID:                                       */
+/*                    ID of created partition.                           */
+/*                 U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*  Return:        SCH_PARTITION_SUCCESS   OR                            */
+/*                 SCH_PARTITION_DENIED                                  */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_partitionAddTask(U1 partitionID, U1 taskID);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_partitionGetInfo                             */
+/*  Purpose:       Get budget state of a partition.                      */
+/*  Arguments:     U1 partitionID:                                       */
+/*                    ID of created partition.                           */
+/*                 OSPartitionInfo* info:                                */
+/*                    Partition state is copied here.                    */
+/*  Return:        SCH_PARTITION_SUCCESS   OR                            */
+/*                 SCH_PARTITION_DENIED                                  */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_partitionGetInfo(U1 partitionID, OSPartitionInfo* info);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_scheduleTableStart                           */
+/*  Purpose:       Start releasing tasks from a static schedule table.   */
+/*                 Each hyperperiod, SysTick wakes the task of each entry*/
+/*                 on the tick given by its offset. Table tasks call     */
+/*                 vd_OSsch_scheduleTableWait() when their work is done. */
+/*                 Other tasks are scheduled by priority in the gaps, so */
+/*                 table tasks should have the highest priorities.       */
+/*  Arguments:     const OSScheduleEntry* table:                         */
+/*                    Entries sorted by offset. Must stay valid while    */
+/*                    table is running.                                  */
+/*                 U1 numEntries:                                        */
+/*                    Number of entries in table.                        */
+/*                 U4 hyperperiod:                                       */
+/*                    Table length in ticks. Offsets must be below this. */
+/*  Return:        SCH_TABLE_START_SUCCESS   OR                          */
+/*                 SCH_TABLE_START_DENIED                                */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_scheduleTableStart(const OSScheduleEntry* table, U1 numEntries, U4 hyperperiod);
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_scheduleTableStop                            */
+/*  Purpose:       Stop releasing tasks from schedule table.             */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+void vd_OSsch_scheduleTableStop(void);
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_scheduleTableWait                            */
+/*  Purpose:       Suspend current table task until its next release.    */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+void vd_OSsch_scheduleTableWait(void);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u4_OSsch_scheduleTableGetOverruns                     */
+/*  Purpose:       Number of table releases of a task that had not yet   */
+/*                 finished its previous release. Such a task is not     */
+/*                 woken, so a task blocked on a resource stays blocked. */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U4: Number of missed releases since table started.    */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+U4 u4_OSsch_scheduleTableGetOverruns(void);
+#endif
+
 /*************************************************************************/
 /*  Function Name: vd_OSsch_start                                        */
 /*  Purpose:       Give control to operating system.                     */
@@ -153,6 +499,7 @@ U4 u4_OSsch_getCurrentTickPeriodMs(void);
 /*                 SCH_TASK_WAKEUP_SEMA_READY             OR             */
 /*                 SCH_TASK_WAKEUP_FLAGS_EVENT            OR             */
 /*                 SCH_TASK_WAKEUP_MUTEX_READY            OR             */
+/*                 SCH_TASK_WAKEUP_NOTIFY                 OR             */
 /*                 OS flags event that triggered wakeup                  */
 /*************************************************************************/
 U1 u1_OSsch_getReasonForWakeup(void);
@@ -165,6 +512,15 @@ U1 u1_OSsch_getReasonForWakeup(void);
 /*************************************************************************/
 U4 u4_OSsch_getTicks(void);
 
+/*************************************************************************/
+/*  Function Name: u8_OSsch_getTicks64                                   */
+/*  Purpose:       Get 64-bit number of ticks from scheduler. Does not   */
+/*                 overflow in practice. Safe to call from any context.  */
+/*  Arguments:     N/A                                                   */
+/*  Return:        Number of scheduler ticks since OS init.              */
+/*************************************************************************/
+U8 u8_OSsch_getTicks64(void);
+
 /*************************************************************************/
 /*  Function Name: u1_OSsch_getCurrentTaskID                             */
 /*  Purpose:       Returns current task ID.                              */
@@ -181,6 +537,112 @@ U1 u1_OSsch_getCurrentTaskID(void);
 /*************************************************************************/
 U1 u1_OSsch_getCurrentTaskPrio(void);
 
+/*************************************************************************/
+/*  Function Name: u1_OSsch_setTaskPriority                              */
+/*  Purpose:       Change priority of task. May be called from ISR.      */
+/*                 Denied while task runs at a priority inherited from a */
+/*                 mutex, or if another task has new priority and        */
+/*                 round-robin is disabled. Holder of mutex task is      */
+/*                 blocked on gains or loses inherited priority.         */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*                 U1 newPriority:                                       */
+/*                    New priority level. 0 = highest.                   */
+/*  Return:        SCH_SET_PRIORITY_SUCCESS   OR                         */
+/*                 SCH_SET_PRIORITY_DENIED                               */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_DYNAMIC_PRIORITY == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_setTaskPriority(U1 taskID, U1 newPriority);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_priorityTraceRead                            */
+/*  Purpose:       Copy recorded priority changes, oldest first, and     */
+/*                 remove them from trace buffer. Oldest entries are     */
+/*                 overwritten if buffer is full.                        */
+/*  Arguments:     OSPriorityTraceEntry* entries:                        */
+/*                    Array to copy entries to.                          */
+/*                 U1 maxEntries:                                        */
+/*                    Size of array.                                     */
+/*  Return:        U1: Number of entries copied.                         */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PRIORITY_TRACE == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_priorityTraceRead(OSPriorityTraceEntry* entries, U1 maxEntries);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_idleJobPost                                  */
+/*  Purpose:       Queue job to be run by background task when no other */
+/*                 task is ready. Jobs run in the order posted. Step     */
+/*                 function is called repeatedly until it returns        */
+/*                 SCH_IDLE_JOB_DONE. Each step should take well under   */
+/*                 RTOS_CONFIG_IDLE_JOB_BUDGET_CYCLES, since budget is   */
+/*                 only checked between steps. May be called from ISR.   */
+/*  Arguments:     OSIdleJob* job:                                       */
+/*                    Job storage. Must be zero before first post and    */
+/*                    must not be modified while queued.                 */
+/*                 U1 (*step)(void* arg):                                */
+/*                    Step function. Returns SCH_IDLE_JOB_DONE or        */
+/*                    SCH_IDLE_JOB_MORE.                                 */
+/*                 void* arg:                                            */
+/*                    Passed to step function.                           */
+/*  Return:        SCH_IDLE_JOB_POST_SUCCESS   OR                        */
+/*                 SCH_IDLE_JOB_POST_DENIED if job is already queued.    */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_IDLE_JOBS == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_idleJobPost(OSIdleJob* job, U1 (*step)(void* arg), void* arg);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_idleRegisterSleepState                       */
+/*  Purpose:       Register sleep state with idle governor. Each time    */
+/*                 CPU goes idle, governor predicts idle length from the */
+/*                 next scheduled wake-up, corrected by how early recent */
+/*                 idle periods ended. Of the states with latency below  */
+/*                 prediction, the one of lowest power cost is chosen.   */
+/*                 app_OSPreSleepFcn() and app_OSPostSleepFcn() enter    */
+/*                 and exit the state from u1_OSsch_idleGetSleepState(). */
+/*  Arguments:     U1 stateID:                                           */
+/*                    Index of state, below                              */
+/*                    RTOS_CONFIG_IDLE_NUM_SLEEP_STATES.                 */
+/*                 U4 latencyUs:                                         */
+/*                    Entry plus exit latency in microseconds.           */
+/*                 U4 powerCost:                                         */
+/*                    Relative power while in state.                     */
+/*  Return:        SCH_SLEEP_STATE_SUCCESS   OR                          */
+/*                 SCH_SLEEP_STATE_DENIED                                */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_IDLE_GOVERNOR == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_idleRegisterSleepState(U1 stateID, U4 latencyUs, U4 powerCost);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_idleGetSleepState                            */
+/*  Purpose:       Return sleep state chosen by idle governor for the    */
+/*                 current idle period. Called by sleep hook functions.  */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U1: State ID   OR                                     */
+/*                 SCH_SLEEP_STATE_NONE                                  */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_IDLE_GOVERNOR == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_idleGetSleepState(void);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_idleGetSleepStats                            */
+/*  Purpose:       Copy residency and misprediction statistics of sleep  */
+/*                 state.                                                */
+/*  Arguments:     U1 stateID:                                           */
+/*                    Index of state.                                    */
+/*                 OSSleepStateStats* stats:                             */
+/*                    Structure to copy statistics to.                   */
+/*  Return:        SCH_SLEEP_STATE_SUCCESS   OR                          */
+/*                 SCH_SLEEP_STATE_DENIED                                */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_IDLE_GOVERNOR == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_idleGetSleepStats(U1 stateID, OSSleepStateStats* stats);
+#endif
+
 /*************************************************************************/
 /*  Function Name: u1_OSsch_getCPULoad                                   */
 /*  Purpose:       Returns CPU load averaged over 100 ticks.             */
@@ -191,6 +653,64 @@ U1 u1_OSsch_getCurrentTaskPrio(void);
 U1 u1_OSsch_getCPULoad(void);
 #endif
 
+/*************************************************************************/
+/*  Function Name: u8_OSsch_getTaskRunCycles                             */
+/*  Purpose:       Returns total CPU cycles a task has run for.          */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task. RTOS_CONFIG_MAX_NUM_TASKS gives idle.  */
+/*  Return:        U8: Number of CPU cycles. Zero if ID is not valid.    */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE)
+U8 u8_OSsch_getTaskRunCycles(U1 taskID);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u4_OSsch_getTaskMaxBurst                              */
+/*  Purpose:       Returns longest time a task has run without being     */
+/*                 switched out.                                         */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*  Return:        U4: Number of CPU cycles. Zero if ID is not valid.    */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE)
+U4 u4_OSsch_getTaskMaxBurst(U1 taskID);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_getTaskLoad                                  */
+/*  Purpose:       Returns CPU load of a task over the last 100 ticks.   */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*  Return:        U1: CPU load as a percentage. Zero if ID is not valid.*/
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_getTaskLoad(U1 taskID);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u4_OSsch_getTaskStackMinFree                          */
+/*  Purpose:       Returns fewest unused stack words measured for a task */
+/*                 since it was created. Measured incrementally by the   */
+/*                 background task, so value may lag actual usage.       */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*  Return:        U4: Number of stack words. Zero if ID is not valid.   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_STACK_WATERMARK == RTOS_CONFIG_TRUE)
+U4 u4_OSsch_getTaskStackMinFree(U1 taskID);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u4_OSsch_getBackgroundStackMinFree                    */
+/*  Purpose:       Returns fewest unused stack words measured for the    */
+/*                 background task.                                      */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U4: Number of stack words.                            */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_STACK_WATERMARK == RTOS_CONFIG_TRUE)
+U4 u4_OSsch_getBackgroundStackMinFree(void);
+#endif
+
 /*************************************************************************/
 /*  Function Name: vd_OSsch_setNewTickPeriod                             */
 /*  Purpose:       Set new tick period in milliseconds.                  */
@@ -214,30 +734,146 @@ void vd_OSsch_taskSleep(U4 period);
 /*  Purpose:       Used to set task to sleep such that task will run at a*/
 /*                 set frequency.                                        */
 /*  Arguments:     U4 nextWakeTime:                                      */
-/*                    Time to wake up at (in ticks).                     */
+/*                    Time to wake up at (in ticks). If this time has    */
+/*                    already passed, task does not sleep.               */
 /*  Return:        U4 u4_t_wakeTime:                                     */
 /*                    Tick value that task was most recently woken at.   */
 /*************************************************************************/
 U4 u4_OSsch_taskSleepSetFreq(U4 nextWakeTime);
 
+/*************************************************************************/
+/*  Function Name: u1_OSsch_taskWaitNextPeriod                           */
+/*  Purpose:       Complete current job of periodic task and block until */
+/*                 next release. First call waits for first release.     */
+/*                 If next release has already passed, returns at once.  */
+/*  Arguments:     N/A                                                   */
+/*  Return:        SCH_PERIODIC_ON_TIME        OR                        */
+/*                 SCH_PERIODIC_OVERRUN        OR                        */
+/*                 SCH_PERIODIC_NOT_PERIODIC                             */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PERIODIC_TASKS == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_taskWaitNextPeriod(void);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_getPeriodicStats                             */
+/*  Purpose:       Get timing statistics of a periodic task.             */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*                 OSPeriodicStats* stats:                               */
+/*                    Statistics are copied here.                        */
+/*  Return:        SCH_PERIODIC_STATS_SUCCESS   OR                       */
+/*                 SCH_PERIODIC_STATS_DENIED                             */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PERIODIC_TASKS == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_getPeriodicStats(U1 taskID, OSPeriodicStats* stats);
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_resetPeriodicStats                           */
+/*  Purpose:       Clear timing statistics of a periodic task. Release   */
+/*                 schedule is not changed.                              */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PERIODIC_TASKS == RTOS_CONFIG_TRUE)
+void vd_OSsch_resetPeriodicStats(U1 taskID);
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_taskYield                                    */
+/*  Purpose:       Move current task to the tail of its priority level   */
+/*                 and run the next ready task at that level, if any.    */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_ROUND_ROBIN == RTOS_CONFIG_TRUE)
+void vd_OSsch_taskYield(void);
+#endif
+
 /*************************************************************************/
 /*  Function Name: vd_OSsch_taskWake                                     */
 /*  Purpose:       Wake specified task from sleep or suspended state.    */
+/*                 Kernel task IDs and deleted tasks are ignored.        */
 /*  Arguments:     U1 taskID:                                            */
 /*                    Task ID to be woken from sleep or suspend state.   */
 /*  Return:        N/A                                                   */
 /*************************************************************************/
 void vd_OSsch_taskWake(U1 taskID); 
 
+/*************************************************************************/
+/*  Function Name: vd_OSsch_wakeBatchBegin                               */
+/*  Purpose:       Clear wake batch before tasks are added.              */
+/*  Arguments:     OSWakeBatch* batch:                                   */
+/*                    Batch owned by caller.                             */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_WAKE_BATCH == RTOS_CONFIG_TRUE)
+void vd_OSsch_wakeBatchBegin(OSWakeBatch* batch);
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_wakeBatchAdd                                 */
+/*  Purpose:       Add task to wake batch. Task is not woken until batch */
+/*                 is committed.                                         */
+/*  Arguments:     OSWakeBatch* batch:                                   */
+/*                    Batch owned by caller.                             */
+/*                 U1 taskID:                                            */
+/*                    Task ID to be woken from sleep or suspend state.   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_WAKE_BATCH == RTOS_CONFIG_TRUE)
+void vd_OSsch_wakeBatchAdd(OSWakeBatch* batch, U1 taskID);
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_wakeBatchCommit                              */
+/*  Purpose:       Wake all tasks in batch under one critical section.   */
+/*                 Preemption is checked and dispatcher triggered once,  */
+/*                 after all tasks are ready. Batch is cleared.          */
+/*  Arguments:     OSWakeBatch* batch:                                   */
+/*                    Batch owned by caller.                             */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_WAKE_BATCH == RTOS_CONFIG_TRUE)
+void vd_OSsch_wakeBatchCommit(OSWakeBatch* batch);
+#endif
+
 /*************************************************************************/
 /*  Function Name: vd_OSsch_taskSuspend                                  */
 /*  Purpose:       Suspend current task for a specified amount of time.  */
+/*                 Kernel task IDs and deleted tasks are ignored.        */
 /*  Arguments:     U1 taskIndex:                                         */
 /*                    Task ID to be suspended.                           */
 /*  Return:        N/A                                                   */
 /*************************************************************************/
 void vd_OSsch_taskSuspend(U1 taskIndex);  
 
+/*************************************************************************/
+/*  Function Name: u1_OSsch_taskDelete                                   */
+/*  Purpose:       Delete task and free its TCB and task ID for reuse.   */
+/*                 Denied if task owns a mutex, or if task deletes       */
+/*                 itself while holding scheduler lock.                  */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task to be deleted. May be current task.     */
+/*  Return:        SCH_TASK_DELETE_SUCCESS   OR                          */
+/*                 SCH_TASK_DELETE_DENIED                                */
+/*************************************************************************/
+U1 u1_OSsch_taskDelete(U1 taskID);
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_taskRestart                                  */
+/*  Purpose:       Restart task from its entry point with a fresh stack. */
+/*                 Denied if task owns a mutex, or if task restarts      */
+/*                 itself while holding scheduler lock.                  */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task to be restarted. May be current task.   */
+/*  Return:        SCH_TASK_RESTART_SUCCESS   OR                         */
+/*                 SCH_TASK_RESTART_DENIED                               */
+/*************************************************************************/
+U1 u1_OSsch_taskRestart(U1 taskID);
+
 /*************************************************************************/
 /*  Function Name: vd_OSsch_suspendScheduler                             */
 /*  Purpose:       Turn off scheduler interrupts and reset ticker.       */
@@ -246,6 +882,70 @@ void vd_OSsch_taskSuspend(U1 taskIndex);
 /*************************************************************************/
 void vd_OSsch_suspendScheduler(void);
 
+/*************************************************************************/
+/*  Function Name: vd_OSsch_lockScheduler                                */
+/*  Purpose:       Prevent preemption of current task without masking    */
+/*                 interrupts. Supports nesting. Task must not block     */
+/*                 while scheduler is locked. If it does, other tasks    */
+/*                 are scheduled normally and a lock call from one of    */
+/*                 them calls OSTaskFault(). Not callable from ISR.      */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_lockScheduler(void);
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_unlockScheduler                              */
+/*  Purpose:       Release scheduler lock. Final unlock runs any         */
+/*                 reschedule that was deferred while lock was held.     */
+/*                 Ignored if current task does not hold lock.           */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_unlockScheduler(void);
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_taskNotify                                   */
+/*  Purpose:       Send notification directly to task. Wakes task if it  */
+/*                 is waiting for a notification. Callable from ISR.     */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task to notify.                              */
+/*                 U4 value:                                             */
+/*                    Used by SCH_NOTIFY_SET_BITS and                    */
+/*                    SCH_NOTIFY_OVERWRITE, otherwise ignored.           */
+/*                 U1 action:                                            */
+/*                    SCH_NOTIFY_GIVE        OR                          */
+/*                    SCH_NOTIFY_SET_BITS    OR                          */
+/*                    SCH_NOTIFY_INCREMENT   OR                          */
+/*                    SCH_NOTIFY_OVERWRITE                               */
+/*  Return:        SCH_NOTIFY_SUCCESS   OR                               */
+/*                 SCH_NOTIFY_DENIED                                     */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_TASK_NOTIFY == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_taskNotify(U1 taskID, U4 value, U1 action);
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_taskNotifyWait                               */
+/*  Purpose:       Wait for notification to current task. Pending state  */
+/*                 is cleared on return.                                 */
+/*  Arguments:     U4 clearBitsOnExit:                                   */
+/*                    Bits cleared in notification value if notification */
+/*                    was received. MAX_VAL_4BYTE resets value to zero.  */
+/*                 U4* notifyValue:                                      */
+/*                    Notification value before bits are cleared is      */
+/*                    written here. May be NULL.                         */
+/*                 U4 blockPeriod:                                       */
+/*                    Ticks to wait. SCH_NOTIFY_NO_BLOCK to return       */
+/*                    immediately, SCH_NOTIFY_WAIT_FOREVER for no        */
+/*                    timeout.                                           */
+/*  Return:        SCH_NOTIFY_RECEIVED   OR                              */
+/*                 SCH_NOTIFY_TIMEOUT                                    */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_TASK_NOTIFY == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_taskNotifyWait(U4 clearBitsOnExit, U4* notifyValue, U4 blockPeriod);
+#endif
+
 /*************************************************************************/
 /*  Function Name: app_OSPreSleepFcn                                     */
 /*  Purpose:       Hook function. Will run before CPU put to sleep.      */
@@ -266,6 +966,22 @@ void app_OSPreSleepFcn(void);
 void app_OSPostSleepFcn(void);
 #endif
 
+/*************************************************************************/
+/*  Function Name: app_OSStackFaultFcn                                   */
+/*  Purpose:       Hook function. Runs in fault handler when a task      */
+/*                 overflows into its MPU stack guard region. OS halts   */
+/*                 in OSTaskFault() if hook returns.                     */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task that overflowed its stack.              */
+/*                 void* faultAddress:                                   */
+/*                    Faulting data address, or NULL if not known (fault */
+/*                    hit while stacking exception frame).               */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if((RTOS_CONFIG_ENABLE_MPU_STACK_GUARD == RTOS_CONFIG_TRUE) && (RTOS_CONFIG_STACK_FAULT_FUNC == RTOS_CONFIG_TRUE))
+void app_OSStackFaultFcn(U1 taskID, void* faultAddress);
+#endif
+
 /*************************************************************************/
 /*  Global Variables                                                     */
 /*************************************************************************/
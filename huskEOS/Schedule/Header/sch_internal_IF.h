@@ -14,34 +14,153 @@
 /*************************************************************************/
 /*  Definitions                                                          */
 /*************************************************************************/
-#define SCH_MAX_NUM_TASKS                   (RTOS_CONFIG_MAX_NUM_TASKS + ONE)  
+#if(RTOS_CONFIG_ENABLE_TICK_TASK == RTOS_CONFIG_TRUE)
+#define SCH_NUM_OS_TASKS                    (TWO)                               /* Background task and tick task. */
+#else
+#define SCH_NUM_OS_TASKS                    (ONE)                               /* Background task. */
+#endif
+#define SCH_MAX_NUM_TASKS                   (RTOS_CONFIG_MAX_NUM_TASKS + SCH_NUM_OS_TASKS)  
 #define SCH_TASK_SLEEP_RESOURCE_MBOX        (SCH_TASK_WAKEUP_MBOX_READY)
 #define SCH_TASK_SLEEP_RESOURCE_QUEUE       (SCH_TASK_WAKEUP_QUEUE_READY)
 #define SCH_TASK_SLEEP_RESOURCE_SEMA        (SCH_TASK_WAKEUP_SEMA_READY)      
 #define SCH_TASK_SLEEP_RESOURCE_FLAGS       (SCH_TASK_WAKEUP_FLAGS_EVENT)
 #define SCH_TASK_SLEEP_RESOURCE_MUTEX       (SCH_TASK_WAKEUP_MUTEX_READY)
 #define SCH_SET_PRIORITY_FAILED             (0)
+#define SCH_NUM_PRIORITY_LEVELS             (0xF1)                              /* Priorities 0x00 - 0xEF for application, 0xF0 for background task. */
+#define SCH_PRIO_GROUP_SHIFT                (5)                                 /* 32 priority levels per bitmap word. */
+#define SCH_PRIO_GROUP_MASK                 (0x1F)
+#define SCH_PRIO_NUM_GROUPS                 ((SCH_NUM_PRIORITY_LEVELS + SCH_PRIO_GROUP_MASK) >> SCH_PRIO_GROUP_SHIFT)
 
 /*************************************************************************/
 /*  Data Types                                                           */
 /*************************************************************************/
 struct ListNode; /* Forward declaration. Defined in "listMgr_internal.h" */
 
+#if(RTOS_CONFIG_ENABLE_PERIODIC_TASKS == RTOS_CONFIG_TRUE)
+/* Release parameters and timing statistics of a periodic task. All times in ticks. */
+typedef struct Sch_Periodic
+{
+  U4 period;           /* Release period. Zero if task is not periodic. */
+  U4 relDeadline;      /* Deadline relative to each release. */
+  U4 nextRelease;      /* Absolute tick of next release. */
+  U4 releaseTick;      /* Absolute tick of current release. */
+  U1 jobActive;        /* Task is running a job that has not completed. */
+  U4 releases;         /* Number of jobs started. */
+  U4 completions;      /* Number of jobs completed. */
+  U4 maxJitter;        /* Longest delay from release to job start. */
+  U4 maxResponse;      /* Longest delay from release to job completion. */
+  U8 responseTotal;    /* Sum of response times, for average. */
+  U4 overruns;         /* Jobs that completed at or after next release. */
+  U4 deadlineMisses;   /* Jobs that completed at or after their deadline. */
+}
+Sch_Periodic;
+#endif
+
 typedef struct Sch_Task
 {
   OS_STACK*  stackPtr;        /* Task stack pointer must be first entry in struct. */
   U1         priority;        /* Task priority. */
   U1         taskID;          /* Task ID. Task can be referenced via this number. */
   U1         flags;           /* Status flags used for scheduling. */
-  U4         sleepCntr;       /* Sleep counter. Unit is scheduler ticks. */
+  U4         sleepCntr;       /* Sleep counter. Unit is scheduler ticks, relative to previous task in sleep list. */
   void*      resource;        /* If task is blocked on a resource, its address is stored here. */
   U1         wakeReason;      /* Stores code for reason task was most recently woken up. */
+  void     (*taskFcn)(void);  /* Task entry point. Used to restart task. */
+  OS_STACK*  stackBase;       /* Bottom of task stack (first entry used). Used to restart task. */
 #if(RTOS_CONFIG_ENABLE_STACK_OVERFLOW_DETECT == RTOS_CONFIG_TRUE)
   OS_STACK*  topOfStack;      /* Pointer to stack watermark. Used to detect stack overflow. */
 #endif
+#if(RTOS_CONFIG_ENABLE_STACK_WATERMARK == RTOS_CONFIG_TRUE)
+  U4         stackSize;       /* Stack size in words. */
+  U4         stackMinFree;    /* Fewest unused stack words seen, counted from end of stack. */
+#endif
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+  U4         relDeadline;     /* Relative deadline in ticks. Zero if task has no deadline. */
+  U4         period;          /* Release period in ticks. Zero if task is aperiodic. */
+  U4         absDeadline;     /* Absolute deadline (tick) of current release. */
+  U4         releaseTick;     /* Tick of current release. Next release is at least one period later. */
+  U1         jobDone;         /* Task finished its job by sleeping or suspending itself. Next wake is a release. */
+  U1         deadlineInherited; /* Task holds a mutex that a deadline task is blocked on. */
+  U4         inheritedDeadline; /* Earliest absolute deadline of those blocked tasks. */
+#endif
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+  U1         preemptThreshold; /* Only tasks of higher priority than this may preempt task once it runs. */
+  U1         basePriority;     /* Priority before being raised to threshold. Undefined (0xFF) if not raised. */
+  U1         sharedStack;      /* Task runs to completion on a shared stack. Stack frame is built on each dispatch. */
+#endif
+#if(RTOS_CONFIG_ENABLE_DYNAMIC_PRIORITY == RTOS_CONFIG_TRUE)
+  U1         assignedPriority; /* Priority set at creation or by application. Differs from priority while inherited. */
+#endif
+#if(RTOS_CONFIG_ENABLE_PERIODIC_TASKS == RTOS_CONFIG_TRUE)
+  Sch_Periodic periodic;      /* Release parameters and statistics if task is periodic. */
+#endif
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+  U1         partition;       /* Partition task belongs to. 0xFF if none. */
+  U1         throttled;       /* Task was suspended because partition budget is exhausted. */
+  struct Sch_Task* partitionNext; /* Next task in member list of partition. */
+#endif
+#if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+  U1         tableWait;       /* Task is suspended waiting for its next table release. */
+#endif
+#if(RTOS_CONFIG_ENABLE_TASK_NOTIFY == RTOS_CONFIG_TRUE)
+  U4         notifyValue;     /* Direct-to-task notification value. */
+  U1         notifyState;     /* Notification not waited on, waited on, or pending. */
+#endif
+#if(RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE)
+  U8         runCycles;       /* Total CPU cycles task has run for. */
+  U4         maxBurstCycles;  /* Longest time task has run without being switched out. */
+  U4         windowCycles;    /* CPU cycles run in current load window. */
+  U1         loadPercent;     /* CPU load of task over previous load window. */
+#endif
 }
 Sch_Task;
 
+/* Ready queue. One list per priority level, indexed by a two-level bitmap so that the highest
+   priority ready task is found with two count-leading-zeros operations. With EDF scheduling
+   the ready queue is a single list ordered by absolute deadline. */
+typedef struct Sch_ReadyQueue
+{
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+  struct ListNode* deadlineList;                              /* Head of list of ready tasks, earliest deadline first. */
+#else
+  U4               groupMap;                                  /* Bit set (MSB first) for each prioMap word that is non-zero. */
+  U4               prioMap[SCH_PRIO_NUM_GROUPS];              /* Bit set (MSB first) for each priority level with a ready task. */
+  struct ListNode* prioList[SCH_NUM_PRIORITY_LEVELS];         /* Head of list of ready tasks at each priority level. */
+#if(RTOS_CONFIG_ENABLE_ROUND_ROBIN == RTOS_CONFIG_TRUE)
+  struct ListNode* prioTail[SCH_NUM_PRIORITY_LEVELS];         /* Tail of list at each priority level for FIFO insertion. */
+#endif
+#endif
+}
+Sch_ReadyQueue;
+
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+/* Group of tasks sharing a CPU budget. Budget is charged one tick each time SysTick interrupts a task of the partition. */
+typedef struct Sch_Partition
+{
+  const char* name;           /* Name for debug. */
+  U4          budget;         /* Ticks partition may run per major frame. Zero if partition is not created. */
+  U4          remaining;      /* Ticks left in current major frame. */
+  U4          exhaustCount;   /* Number of major frames in which budget ran out. */
+  Sch_Task*   members;        /* First task of partition. Linked by partitionNext. */
+}
+Sch_Partition;
+#endif
+
+#if(RTOS_CONFIG_ENABLE_IDLE_GOVERNOR == RTOS_CONFIG_TRUE)
+/* Sleep state registered with idle governor, and its statistics. */
+typedef struct Sch_SleepState
+{
+  U1 registered;              /* State may be chosen. */
+  U4 latencyUs;               /* Entry plus exit latency. State is only chosen if predicted idle is longer. */
+  U4 powerCost;               /* Relative power while in state. Lowest cost of valid states is chosen. */
+  U4 entries;                 /* Number of times state was chosen. */
+  U8 residencyTicks;          /* Total ticks spent idle in state. */
+  U4 tooDeep;                 /* Idle ended within state latency. */
+  U4 tooShallow;              /* Idle was long enough for a state of lower power cost. */
+}
+Sch_SleepState;
+#endif
+
 #if (RTOS_CONFIG_CALC_TASK_CPU_LOAD == RTOS_CONFIG_TRUE)
 /* Used to calculate CPU load. */
 typedef struct CPU_IdleCalc
@@ -107,6 +226,36 @@ void vd_OSsch_setReasonForSleep(void* taskSleepResource, U1 resourceType, U4 per
 /*************************************************************************/
 U1 u1_OSsch_setNewPriority(struct Sch_Task* tcb, U1 newPriority);
 
+/*************************************************************************/
+/*  Function Name: vd_OSsch_setInheritedDeadline                         */
+/*  Purpose:       Set absolute deadline that mutex holder inherits from */
+/*                 tasks blocked on it, in support of priority           */
+/*                 inheritance under EDF. Task runs by the earlier of    */
+/*                 its own and the inherited deadline. Internal use only.*/
+/*  Arguments:     Sch_Task* tcb:                                        */
+/*                           Pointer to TCB of mutex holder.             */
+/*                 U1 inherit:                                           */
+/*                           ONE to inherit deadline, ZERO to return to  */
+/*                           own deadline.                               */
+/*                 U4 deadline:                                          */
+/*                           Absolute deadline to inherit.               */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+void vd_OSsch_setInheritedDeadline(struct Sch_Task* tcb, U1 inherit, U4 deadline);
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_dispatchHook                                 */
+/*  Purpose:       Called by dispatcher with interrupts disabled before  */
+/*                 switching from tcb_g_p_currentTaskBlock to            */
+/*                 tcb_g_p_nextTaskBlock. Default port implementation    */
+/*                 is empty.                                             */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_dispatchHook(void);
+
 /*************************************************************************/
 /*  Global Variables                                                     */
 /*************************************************************************/
@@ -39,6 +39,15 @@
 #include "memory_internal_IF.h"
 #endif
 
+#if(RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE)
+#include "trace_internal_IF.h"
+#include "trace.h"
+#endif
+
+#if(RTOS_CFG_OS_PROFILE_ENABLED == RTOS_CONFIG_TRUE)
+#include "prof_internal_IF.h"
+#endif
+
 /*************************************************************************/
 /*  External References                                                  */
 /*************************************************************************/
@@ -75,9 +84,103 @@ extern void OSTaskFault(void);
 #define SCH_TASK_PRIORITY_UNDEFINED              (0xFF)
 #define SCH_TASK_LOWEST_PRIORITY                 (0xF0)
 #define SCH_INVALID_TASK_ID                      (0xFF)
-#define SCH_BG_TASK_ID                           (SCH_MAX_NUM_TASKS - 1)
+#define SCH_BG_TASK_ID                           (RTOS_CONFIG_MAX_NUM_TASKS)
+#define SCH_TICK_TASK_ID                         (SCH_BG_TASK_ID + ONE)
+#define SCH_TICK_TASK_PRIORITY                   (RTOS_CONFIG_TICK_TASK_PRIORITY)
+#define SCH_TICK_TASK_STACK_SIZE                 (RTOS_CONFIG_TICK_TASK_STACK_SIZE)
+#if(RTOS_CONFIG_ENABLE_TICK_TASK == RTOS_CONFIG_TRUE)
+#define SCH_APP_PRIORITY_INVALID(prio)           (((prio) >= SCH_TASK_LOWEST_PRIORITY) || ((prio) == SCH_TICK_TASK_PRIORITY))
+#else
+#define SCH_APP_PRIORITY_INVALID(prio)           ((prio) >= SCH_TASK_LOWEST_PRIORITY)
+#endif
 #define SCH_NULL_PTR                             ((void*)ZERO)
-#define SCH_MAX_NUM_TICK                         (4294967200U)
+#define SCH_DIV_HUNDRED_MULT                     (5243)                              /* (x * 5243) >> 19 equals x / 100 for x below 43699. */
+#define SCH_DIV_HUNDRED_SHIFT                    (19)
+#define SCH_PRIO_MAP_MSB                         (0x80000000)
+#define SCH_MIN_SLEEP_TICKS                      (1)
+#define SCH_TICKLESS_MIN_IDLE_TICKS              (2)
+#define SCH_TICKLESS_NO_WAKEUP_PENDING           (MAX_VAL_4BYTE)
+#define SCH_TIME_SLICE_TICKS                     (RTOS_CONFIG_TIME_SLICE_TICKS)
+#define SCH_PRIO_TRACE_SIZE                      (RTOS_CONFIG_PRIORITY_TRACE_SIZE)
+#define SCH_NUM_SLEEP_STATES                     (RTOS_CONFIG_IDLE_NUM_SLEEP_STATES)
+#define SCH_IDLE_CORRECTION_ONE                  (256)                               /* Idle length correction factor is fixed point, 8 fraction bits. */
+#define SCH_IDLE_CORRECTION_SHIFT                (8)
+#define SCH_IDLE_CORRECTION_WEIGHT_SHIFT         (3)                                 /* Each idle period has weight 1/8 in correction factor. */
+#define SCH_US_PER_MS                            (1000)
+#define SCH_SLOT_MAP_SHIFT                       (5)                                 /* 32 TCB slots per bitmap word. */
+#define SCH_SLOT_MAP_MASK                        (0x1F)
+#define SCH_SLOT_MAP_NUM_WORDS                   ((SCH_MAX_NUM_TASKS + SCH_SLOT_MAP_MASK) >> SCH_SLOT_MAP_SHIFT)
+#define SCH_NOTIFY_STATE_NOT_WAITING             (0)
+#define SCH_NOTIFY_STATE_WAITING                 (1)
+#define SCH_NOTIFY_STATE_PENDING                 (2)
+#define SCH_STACK_SCAN_WORDS                     (RTOS_CONFIG_STACK_SCAN_WORDS)
+#define SCH_NUM_PARTITIONS                       (RTOS_CONFIG_NUM_PARTITIONS)
+#define SCH_NO_PARTITION                         (0xFF)
+#define SCH_PARTITION_MAX_NUM                    (32)                                /* One bit per partition in throttle mask. */
+
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+  #if(SCH_NUM_PARTITIONS > SCH_PARTITION_MAX_NUM)
+    #error "RTOS_CONFIG_NUM_PARTITIONS CANNOT BE ABOVE 32"
+  #endif
+#endif
+
+#if(RTOS_CONFIG_ENABLE_PRIORITY_TRACE == RTOS_CONFIG_TRUE)
+  #if((SCH_PRIO_TRACE_SIZE > 255) || (SCH_PRIO_TRACE_SIZE == 0))
+    #error "RTOS_CONFIG_PRIORITY_TRACE_SIZE MUST BE 1 - 255"
+  #endif
+#endif
+
+#if(RTOS_CONFIG_ENABLE_IDLE_GOVERNOR == RTOS_CONFIG_TRUE)
+  #if(RTOS_CONFIG_ENABLE_TICKLESS_IDLE != RTOS_CONFIG_TRUE)
+    #error "IDLE GOVERNOR REQUIRES RTOS_CONFIG_ENABLE_TICKLESS_IDLE"
+  #endif
+  #if(RTOS_CONFIG_PRESLEEP_FUNC != RTOS_CONFIG_TRUE)
+    #error "IDLE GOVERNOR REQUIRES RTOS_CONFIG_PRESLEEP_FUNC"
+  #endif
+#endif
+
+#if(RTOS_CONFIG_ENABLE_MPU_STACK_GUARD == RTOS_CONFIG_TRUE)
+  #if(RTOS_CONFIG_ENABLE_STACK_OVERFLOW_DETECT != RTOS_CONFIG_TRUE)
+    #error "MPU STACK GUARD REQUIRES RTOS_CONFIG_ENABLE_STACK_OVERFLOW_DETECT"
+  #endif
+  /* Guard region replaces stack limit mark. Mark would be written inside guard of running task. */
+  #define SCH_STACK_LIMIT_MARK                   (RTOS_CONFIG_FALSE)
+#else
+  #define SCH_STACK_LIMIT_MARK                   (RTOS_CONFIG_ENABLE_STACK_OVERFLOW_DETECT)
+#endif
+
+#if(RTOS_CONFIG_ENABLE_STACK_WATERMARK == RTOS_CONFIG_TRUE)
+  #if(RTOS_CONFIG_ENABLE_STACK_OVERFLOW_DETECT != RTOS_CONFIG_TRUE)
+    #error "STACK WATERMARK REQUIRES RTOS_CONFIG_ENABLE_STACK_OVERFLOW_DETECT"
+  #endif
+  /* Stack word counted from the end of the stack furthest from the stack base. */
+  #if(STACK_GROWTH == STACK_DESCENDING)
+    #define SCH_STACK_WORD_FROM_END(tcb, idx)    (*((tcb)->topOfStack + (idx)))
+  #elif(STACK_GROWTH == STACK_ASCENDING)
+    #define SCH_STACK_WORD_FROM_END(tcb, idx)    (*((tcb)->topOfStack - (idx)))
+  #endif
+#endif
+
+#if(RTOS_CONFIG_ENABLE_TICKLESS_IDLE == RTOS_CONFIG_TRUE)
+  #if(RTOS_CONFIG_ENABLE_BACKGROUND_IDLE_SLEEP != RTOS_CONFIG_TRUE)
+    #error "TICKLESS IDLE REQUIRES RTOS_CONFIG_ENABLE_BACKGROUND_IDLE_SLEEP"
+  #endif
+  #if(RTOS_CONFIG_CALC_TASK_CPU_LOAD == RTOS_CONFIG_TRUE)
+    #error "TICKLESS IDLE CANNOT BE USED WITH RTOS_CONFIG_CALC_TASK_CPU_LOAD"
+  #endif
+#endif
+
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+  #if(RTOS_CONFIG_ENABLE_TICK_TASK == RTOS_CONFIG_TRUE)
+    #error "EDF SCHEDULING CANNOT BE USED WITH RTOS_CONFIG_ENABLE_TICK_TASK"
+  #endif
+  #if(RTOS_CONFIG_ENABLE_ROUND_ROBIN == RTOS_CONFIG_TRUE)
+    #error "EDF SCHEDULING CANNOT BE USED WITH RTOS_CONFIG_ENABLE_ROUND_ROBIN"
+  #endif
+  #if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+    #error "EDF SCHEDULING CANNOT BE USED WITH RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD"
+  #endif
+#endif
 
 /*************************************************************************/
 /*  Global Variables, Constants                                          */
@@ -92,17 +195,73 @@ Sch_Task* tcb_g_p_nextTaskBlock;
 /*  Static Global Variables, Constants                                   */
 /*************************************************************************/
 static U1 u1_s_numTasks;
-static U4 u4_s_tickCntr;
+static U1 u1_s_schLockNest;
+static Sch_Task* tcb_s_p_schLockOwner;                            /* Task that holds scheduler lock. */
+static U1 u1_s_dispatchPending;
+static volatile U4 u4_s_tickCntr;                                 /* Low word of 64-bit tick count. */
+static volatile U4 u4_s_tickCntrHigh;                             /* High word of 64-bit tick count. */
+#if(RTOS_CONFIG_CALC_TASK_CPU_LOAD == RTOS_CONFIG_TRUE)
+static U1 u1_s_cpuLoadWindowTicks;
+#endif
 #if(RTOS_CONFIG_PRESLEEP_FUNC == RTOS_CONFIG_TRUE || RTOS_CONFIG_POSTSLEEP_FUNC == RTOS_CONFIG_TRUE)
 static U1 u1_s_sleepState;
 #endif
-static ListNode* node_s_p_headOfWaitList;
-static ListNode* node_s_p_headOfReadyList;
+#if(RTOS_CONFIG_ENABLE_ROUND_ROBIN == RTOS_CONFIG_TRUE)
+static U4        u4_s_sliceCntr;
+static Sch_Task* tcb_s_p_sliceOwner;
+#endif
+#if(RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE)
+static U4        u4_s_lastSwitchCycles;
+static U4        u4_s_burstCycles;
+static U4        u4_s_loadWindowStartCycles;
+static U4        u4_s_loadWindowTicks;
+#endif
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+static Sch_Partition Part_s_as_partitions[SCH_NUM_PARTITIONS];
+static U4        u4_s_partitionFrameTicks;                        /* Ticks left in current major frame. */
+static U4        u4_s_partitionThrottleMask;                      /* Bit set (LSB first) for each partition with no budget left. */
+#endif
+#if(RTOS_CONFIG_ENABLE_IDLE_GOVERNOR == RTOS_CONFIG_TRUE)
+static Sch_SleepState SleepState_s_as_states[SCH_NUM_SLEEP_STATES];
+static U1        u1_s_idleSleepState;                             /* State chosen for current idle period. */
+static U4        u4_s_idleCorrection;                             /* Average ratio of actual to scheduled idle length. */
+static U4        u4_s_tickPeriodUs;
+#endif
+#if(RTOS_CONFIG_ENABLE_IDLE_JOBS == RTOS_CONFIG_TRUE)
+static OSIdleJob* Job_s_p_idleJobHead;                            /* Job currently being run by background task. */
+static OSIdleJob* Job_s_p_idleJobTail;
+#endif
+#if(RTOS_CONFIG_ENABLE_PRIORITY_TRACE == RTOS_CONFIG_TRUE)
+static OSPriorityTraceEntry PrioTrace_s_as_buffer[SCH_PRIO_TRACE_SIZE];
+static U1        u1_s_prioTraceHead;                              /* Index of oldest entry. */
+static U1        u1_s_prioTraceCount;
+#endif
+#if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+static const OSScheduleEntry* Entry_s_p_scheduleTable;            /* NULL when no table is running. */
+static U1        u1_s_tableNumEntries;
+static U1        u1_s_tableIndex;                                 /* Next entry to release. */
+static U4        u4_s_tableHyperperiod;
+static U4        u4_s_tableTick;                                  /* Position within hyperperiod. */
+static U4        u4_s_tableOverruns;
+#endif
+#if(RTOS_CONFIG_ENABLE_STACK_WATERMARK == RTOS_CONFIG_TRUE)
+static U1        u1_s_stackScanSlot;
+static U4        u4_s_stackScanIndex;
+#endif
+static ListNode* node_s_p_headOfSleepList;
+static ListNode* node_s_p_headOfSuspendList;
+static Sch_ReadyQueue ReadyQ_s_readyQueue;
 static OS_STACK  u4_backgroundStack[SCH_BG_TASK_STACK_SIZE];
+#if(RTOS_CONFIG_ENABLE_TICK_TASK == RTOS_CONFIG_TRUE)
+static OS_STACK  u4_s_tickTaskStack[SCH_TICK_TASK_STACK_SIZE];
+static U4        u4_s_overdueTicks;                               /* Ticks counted by SysTick while head of sleep list was due. Applied to next entry by tick task. */
+#endif
 
 /* Allocate memory for data structures used for TCBs and scheduling queues */
 static ListNode   Node_s_as_listAllTasks[SCH_MAX_NUM_TASKS];     
 static Sch_Task   SchTask_s_as_taskList[SCH_MAX_NUM_TASKS];
+static U4         u4_s_freeSlotMap[SCH_SLOT_MAP_NUM_WORDS];      /* Bit set (MSB first) for each unused TCB slot. */
+static Sch_Task   SchTask_s_discardedContext;                    /* Dispatcher saves context of deleted/restarted running task here. */
 
 #if (RTOS_CONFIG_CALC_TASK_CPU_LOAD == RTOS_CONFIG_TRUE)
 static OS_RunTimeStats OS_s_cpuData;
@@ -113,14 +272,93 @@ static OS_RunTimeStats OS_s_cpuData;
 /*  Private Function Prototypes                                          */
 /*************************************************************************/
 static void vd_OSsch_background(void);
+#if(RTOS_CONFIG_ENABLE_TICK_TASK == RTOS_CONFIG_TRUE)
+static void vd_sch_tickTask(void);
+static void vd_sch_tickApplyOverdue(void);
+#endif
 
-#if(RTOS_CONFIG_ENABLE_STACK_OVERFLOW_DETECT == RTOS_CONFIG_TRUE)
+#if(SCH_STACK_LIMIT_MARK == RTOS_CONFIG_TRUE)
 static U1 u1_sch_checkStack(U1 taskIndex);
 #endif
+#if(RTOS_CONFIG_ENABLE_MPU_STACK_GUARD == RTOS_CONFIG_TRUE)
+static void vd_sch_stackGuardFault(void);
+#endif
+#if(RTOS_CONFIG_ENABLE_STACK_WATERMARK == RTOS_CONFIG_TRUE)
+static void vd_sch_stackScan(void);
+#endif
+#if(RTOS_CONFIG_ENABLE_IDLE_JOBS == RTOS_CONFIG_TRUE)
+static U1 u1_sch_idleJobsRun(void);
+#endif
 
 static void vd_OSsch_setNextReadyTaskToRun(void);
 static void vd_OSsch_taskSleepTimeoutHandler(Sch_Task* taskTCB);
+#if(RTOS_CONFIG_ENABLE_TICK_TASK != RTOS_CONFIG_TRUE)
 static void vd_OSsch_periodicScheduler(void);
+#endif
+static void vd_sch_sleepExpireHead(void);
+static void vd_sch_readyQueueInsert(ListNode* node);
+static void vd_sch_readyQueueRemove(ListNode* node);
+static Sch_Task* tcb_sch_readyQueueHighest(void);
+static U1 u1_sch_allocTaskSlot(void);
+static void vd_sch_freeTaskSlot(U1 slot);
+static void vd_sch_taskUnlink(ListNode* taskNode);
+static U1 u1_sch_taskHoldsResource(Sch_Task* taskTCB);
+#if((RTOS_CONFIG_ENABLE_DYNAMIC_PRIORITY == RTOS_CONFIG_TRUE) && (RTOS_CONFIG_ENABLE_ROUND_ROBIN != RTOS_CONFIG_TRUE))
+static U1 u1_sch_priorityInUse(U1 priority, Sch_Task* exceptTCB);
+#endif
+static void vd_sch_taskRelease(ListNode* taskNode);
+static void vd_sch_taskWake(ListNode* taskNode);
+static void vd_sch_taskSuspend(ListNode* taskNode);
+static void vd_sch_priorityChange(Sch_Task* tcb, U1 newPriority, U1 cause);
+#if(RTOS_CONFIG_ENABLE_PRIORITY_TRACE == RTOS_CONFIG_TRUE)
+static void vd_sch_priorityTraceRecord(Sch_Task* tcb, U1 newPriority, U1 cause);
+#endif
+static void vd_sch_discardCurrentContext(void);
+static void vd_sch_taskReturn(void);
+static void vd_sch_requestDispatch(void);
+static U1 u1_sch_taskCreate(void (*newTaskFcn)(void), void* sp, U4 sizeOfStack, U1 priority, U1 preemptThreshold, U1 taskID, U1 sharedStack);
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+static void vd_sch_thresholdRaise(ListNode* node);
+static void vd_sch_thresholdLower(Sch_Task* taskTCB);
+#endif
+
+#if(RTOS_CONFIG_ENABLE_ROUND_ROBIN == RTOS_CONFIG_TRUE)
+static void vd_sch_timeSlice(void);
+#endif
+
+#if(RTOS_CONFIG_ENABLE_TICKLESS_IDLE == RTOS_CONFIG_TRUE)
+static void vd_sch_ticklessIdle(void);
+static void vd_sch_tickAdvance(U4 numTicks);
+#endif
+#if(RTOS_CONFIG_ENABLE_IDLE_GOVERNOR == RTOS_CONFIG_TRUE)
+static U1 u1_sch_idleSelectState(U4 idleUs);
+static U4 u4_sch_idleTicksToUs(U4 ticks);
+static void vd_sch_idleGovernorUpdate(U4 scheduledTicks, U4 actualTicks);
+#endif
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+static void vd_sch_edfRelease(Sch_Task* taskTCB);
+static void vd_sch_edfNewJob(ListNode* taskNode);
+#endif
+#if(RTOS_CONFIG_ENABLE_PERIODIC_TASKS == RTOS_CONFIG_TRUE)
+static void vd_sch_periodicStatsClear(Sch_Periodic* periodic);
+#endif
+#if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+static void vd_sch_scheduleTableTick(void);
+#if(RTOS_CONFIG_ENABLE_TICKLESS_IDLE == RTOS_CONFIG_TRUE)
+static U4 u4_sch_scheduleTableTicksToNext(void);
+#endif
+#endif
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+static void vd_sch_partitionTick(void);
+static void vd_sch_partitionThrottle(U1 partitionID);
+static void vd_sch_partitionReplenish(void);
+static U1 u1_sch_partitionPark(ListNode* taskNode);
+static void vd_sch_partitionRemoveMember(Sch_Task* taskTCB);
+#endif
+#if(RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE)
+static void vd_sch_runTimeAccount(void);
+static void vd_sch_runTimeLoadWindow(void);
+#endif
 
 /*************************************************************************/
 
@@ -137,7 +375,11 @@ void vd_OS_init(U4 numMsPeriod)
   U1 u1_t_index;
   
   u1_s_numTasks      = (U1)SCH_NUM_TASKS_ZERO;
-  u4_s_tickCntr      = (U1)ZERO;
+  u1_s_schLockNest     = (U1)ZERO;
+  tcb_s_p_schLockOwner = (Sch_Task*)NULL;
+  u1_s_dispatchPending = (U1)SCH_FALSE;
+  u4_s_tickCntr      = (U4)ZERO;
+  u4_s_tickCntrHigh  = (U4)ZERO;
 #if(RTOS_CONFIG_PRESLEEP_FUNC == RTOS_CONFIG_TRUE || RTOS_CONFIG_POSTSLEEP_FUNC == RTOS_CONFIG_TRUE)
   u1_s_sleepState    = (U1)SCH_CPU_NOT_SLEEPING;
 #endif
@@ -152,6 +394,48 @@ void vd_OS_init(U4 numMsPeriod)
     SchTask_s_as_taskList[u1_t_index].wakeReason        = (U1)ZERO;
     SchTask_s_as_taskList[u1_t_index].priority          = (U1)SCH_TASK_PRIORITY_UNDEFINED;
     SchTask_s_as_taskList[u1_t_index].taskID            = (U1)SCH_INVALID_TASK_ID;
+    SchTask_s_as_taskList[u1_t_index].taskFcn           = (void (*)(void))NULL;
+    SchTask_s_as_taskList[u1_t_index].stackBase         = (OS_STACK*)NULL;
+#if(RTOS_CONFIG_ENABLE_STACK_WATERMARK == RTOS_CONFIG_TRUE)
+    SchTask_s_as_taskList[u1_t_index].stackSize         = (U4)ZERO;
+    SchTask_s_as_taskList[u1_t_index].stackMinFree      = (U4)ZERO;
+#endif
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+    SchTask_s_as_taskList[u1_t_index].preemptThreshold  = (U1)SCH_TASK_PRIORITY_UNDEFINED;
+    SchTask_s_as_taskList[u1_t_index].basePriority      = (U1)SCH_TASK_PRIORITY_UNDEFINED;
+    SchTask_s_as_taskList[u1_t_index].sharedStack       = (U1)SCH_FALSE;
+#endif
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+    SchTask_s_as_taskList[u1_t_index].relDeadline       = (U4)ZERO;
+    SchTask_s_as_taskList[u1_t_index].period            = (U4)ZERO;
+    SchTask_s_as_taskList[u1_t_index].absDeadline       = (U4)ZERO;
+    SchTask_s_as_taskList[u1_t_index].releaseTick       = (U4)ZERO;
+    SchTask_s_as_taskList[u1_t_index].jobDone           = (U1)SCH_FALSE;
+    SchTask_s_as_taskList[u1_t_index].deadlineInherited = (U1)SCH_FALSE;
+    SchTask_s_as_taskList[u1_t_index].inheritedDeadline = (U4)ZERO;
+#endif
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+    SchTask_s_as_taskList[u1_t_index].partition         = (U1)SCH_NO_PARTITION;
+    SchTask_s_as_taskList[u1_t_index].throttled         = (U1)SCH_FALSE;
+    SchTask_s_as_taskList[u1_t_index].partitionNext     = (Sch_Task*)NULL;
+#endif
+#if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+    SchTask_s_as_taskList[u1_t_index].tableWait         = (U1)SCH_FALSE;
+#endif
+#if(RTOS_CONFIG_ENABLE_PERIODIC_TASKS == RTOS_CONFIG_TRUE)
+    SchTask_s_as_taskList[u1_t_index].periodic.period   = (U4)ZERO;
+    vd_sch_periodicStatsClear(&SchTask_s_as_taskList[u1_t_index].periodic);
+#endif
+#if(RTOS_CONFIG_ENABLE_TASK_NOTIFY == RTOS_CONFIG_TRUE)
+    SchTask_s_as_taskList[u1_t_index].notifyValue       = (U4)ZERO;
+    SchTask_s_as_taskList[u1_t_index].notifyState       = (U1)SCH_NOTIFY_STATE_NOT_WAITING;
+#endif
+#if(RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE)
+    SchTask_s_as_taskList[u1_t_index].runCycles         = (U8)ZERO;
+    SchTask_s_as_taskList[u1_t_index].maxBurstCycles    = (U4)ZERO;
+    SchTask_s_as_taskList[u1_t_index].windowCycles      = (U4)ZERO;
+    SchTask_s_as_taskList[u1_t_index].loadPercent       = (U1)ZERO;
+#endif
     
     Node_s_ap_mapTaskIDToTCB[u1_t_index]                = (ListNode*)NULL;
     
@@ -160,25 +444,134 @@ void vd_OS_init(U4 numMsPeriod)
     Node_s_as_listAllTasks[u1_t_index].TCB              = (Sch_Task*)NULL;
   }
   
-  /* Initialize linked list head pointers */
-  node_s_p_headOfWaitList   = (ListNode*)NULL;
-  node_s_p_headOfReadyList  = (ListNode*)NULL;
+  /* All TCB slots are free */
+  for(u1_t_index = (U1)ZERO; u1_t_index < (U1)SCH_SLOT_MAP_NUM_WORDS; u1_t_index++)
+  {
+    u4_s_freeSlotMap[u1_t_index] = (U4)ZERO;
+  }
+  
+  for(u1_t_index = (U1)ZERO; u1_t_index < (U1)SCH_MAX_NUM_TASKS; u1_t_index++)
+  {
+    vd_sch_freeTaskSlot(u1_t_index);
+  }
+  
+  /* Placeholder TCB is never scheduled. Marked suspended so tick handling ignores it. */
+  SchTask_s_discardedContext.flags    = (U1)SCH_TASK_FLAG_STS_SUSPENDED;
+  SchTask_s_discardedContext.priority = (U1)SCH_TASK_PRIORITY_UNDEFINED;
+  SchTask_s_discardedContext.taskID   = (U1)SCH_INVALID_TASK_ID;
+  
+  /* Initialize sleep/suspend list head pointers and ready queue */
+  node_s_p_headOfSleepList     = (ListNode*)NULL;
+  node_s_p_headOfSuspendList   = (ListNode*)NULL;
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+  ReadyQ_s_readyQueue.deadlineList = (ListNode*)NULL;
+#else
+  ReadyQ_s_readyQueue.groupMap = (U4)ZERO;
+  
+  for(u1_t_index = (U1)ZERO; u1_t_index < (U1)SCH_PRIO_NUM_GROUPS; u1_t_index++)
+  {
+    ReadyQ_s_readyQueue.prioMap[u1_t_index] = (U4)ZERO;
+  }
+  
+  for(u1_t_index = (U1)ZERO; u1_t_index < (U1)SCH_NUM_PRIORITY_LEVELS; u1_t_index++)
+  {
+    ReadyQ_s_readyQueue.prioList[u1_t_index] = (ListNode*)NULL;
+#if(RTOS_CONFIG_ENABLE_ROUND_ROBIN == RTOS_CONFIG_TRUE)
+    ReadyQ_s_readyQueue.prioTail[u1_t_index] = (ListNode*)NULL;
+#endif
+  }
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_ROUND_ROBIN == RTOS_CONFIG_TRUE)
+  u4_s_sliceCntr     = (U4)SCH_TIME_SLICE_TICKS;
+  tcb_s_p_sliceOwner = (Sch_Task*)NULL;
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+  for(u1_t_index = (U1)ZERO; u1_t_index < (U1)SCH_NUM_PARTITIONS; u1_t_index++)
+  {
+    Part_s_as_partitions[u1_t_index].name         = (const char*)NULL;
+    Part_s_as_partitions[u1_t_index].budget       = (U4)ZERO;
+    Part_s_as_partitions[u1_t_index].remaining    = (U4)ZERO;
+    Part_s_as_partitions[u1_t_index].exhaustCount = (U4)ZERO;
+    Part_s_as_partitions[u1_t_index].members      = (Sch_Task*)NULL;
+  }
+  
+  u4_s_partitionFrameTicks   = (U4)SCH_PARTITION_MAJOR_FRAME;
+  u4_s_partitionThrottleMask = (U4)ZERO;
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_IDLE_GOVERNOR == RTOS_CONFIG_TRUE)
+  for(u1_t_index = (U1)ZERO; u1_t_index < (U1)SCH_NUM_SLEEP_STATES; u1_t_index++)
+  {
+    SleepState_s_as_states[u1_t_index].registered     = (U1)SCH_FALSE;
+    SleepState_s_as_states[u1_t_index].latencyUs      = (U4)ZERO;
+    SleepState_s_as_states[u1_t_index].powerCost      = (U4)ZERO;
+    SleepState_s_as_states[u1_t_index].entries        = (U4)ZERO;
+    SleepState_s_as_states[u1_t_index].residencyTicks = (U8)ZERO;
+    SleepState_s_as_states[u1_t_index].tooDeep        = (U4)ZERO;
+    SleepState_s_as_states[u1_t_index].tooShallow     = (U4)ZERO;
+  }
+  
+  u1_s_idleSleepState = (U1)SCH_SLEEP_STATE_NONE;
+  u4_s_idleCorrection = (U4)SCH_IDLE_CORRECTION_ONE;
+  u4_s_tickPeriodUs   = numMsPeriod * (U4)SCH_US_PER_MS;
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_IDLE_JOBS == RTOS_CONFIG_TRUE)
+  Job_s_p_idleJobHead = (OSIdleJob*)NULL;
+  Job_s_p_idleJobTail = (OSIdleJob*)NULL;
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_PRIORITY_TRACE == RTOS_CONFIG_TRUE)
+  u1_s_prioTraceHead  = (U1)ZERO;
+  u1_s_prioTraceCount = (U1)ZERO;
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+  Entry_s_p_scheduleTable = (const OSScheduleEntry*)NULL;
+  u1_s_tableNumEntries    = (U1)ZERO;
+  u1_s_tableIndex         = (U1)ZERO;
+  u4_s_tableHyperperiod   = (U4)ZERO;
+  u4_s_tableTick          = (U4)ZERO;
+  u4_s_tableOverruns      = (U4)ZERO;
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_STACK_WATERMARK == RTOS_CONFIG_TRUE)
+  u1_s_stackScanSlot  = (U1)ZERO;
+  u4_s_stackScanIndex = (U4)ZERO;
+#endif
   
   /* Initialize running task pointer */
   tcb_g_p_currentTaskBlock = (Sch_Task*)SCH_TCB_PTR_INIT;
   
 #if (RTOS_CONFIG_CALC_TASK_CPU_LOAD == RTOS_CONFIG_TRUE)
+  u1_s_cpuLoadWindowTicks                           = (U1)SCH_HUNDRED_TICKS;
   OS_s_cpuData.CPUIdlePercent.CPU_idleAvg           = (U1)ZERO;
   OS_s_cpuData.CPUIdlePercent.CPU_idlePrevTimestamp = (U1)ZERO;
   OS_s_cpuData.CPUIdlePercent.CPU_idleRunning       = (U4)ZERO;
 #endif
   
-  /* Create background task */
-  u1_OSsch_createTask(&vd_OSsch_background, 
-                      &u4_backgroundStack[SCH_BG_TASK_STACK_SIZE - ONE], 
-                      (U4)RTOS_CONFIG_BG_TASK_STACK_SIZE, 
-                      (U1)SCH_TASK_LOWEST_PRIORITY, 
-                      (U1)SCH_BG_TASK_ID);
+  /* Create background task. Kernel tasks are created through internal path, application API denies their IDs and priority. */
+  (void)u1_sch_taskCreate(&vd_OSsch_background, 
+                          &u4_backgroundStack[SCH_BG_TASK_STACK_SIZE - ONE], 
+                          (U4)RTOS_CONFIG_BG_TASK_STACK_SIZE, 
+                          (U1)SCH_TASK_LOWEST_PRIORITY, 
+                          (U1)SCH_TASK_LOWEST_PRIORITY, 
+                          (U1)SCH_BG_TASK_ID, 
+                          (U1)SCH_FALSE);
+  
+#if(RTOS_CONFIG_ENABLE_TICK_TASK == RTOS_CONFIG_TRUE)
+  /* Create kernel tick task. It suspends itself the first time it runs. */
+  u4_s_overdueTicks = (U4)ZERO;
+  (void)u1_sch_taskCreate(&vd_sch_tickTask, 
+                          &u4_s_tickTaskStack[SCH_TICK_TASK_STACK_SIZE - ONE], 
+                          (U4)SCH_TICK_TASK_STACK_SIZE, 
+                          (U1)SCH_TICK_TASK_PRIORITY, 
+                          (U1)SCH_TICK_TASK_PRIORITY, 
+                          (U1)SCH_TICK_TASK_ID, 
+                          (U1)SCH_FALSE);
+#endif
   
   /* Mask interrupts until RTOS enters normal operation */
   vd_cpu_disableInterruptsOSStart();
@@ -187,6 +580,14 @@ void vd_OS_init(U4 numMsPeriod)
 #if(RTOS_CFG_OS_MAILBOX_ENABLED == RTOS_CONFIG_TRUE)  
   vd_OSmbox_init();
 #endif
+  
+#if(RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE)
+  vd_OStrace_init();
+#endif
+
+#if(RTOS_CFG_OS_PROFILE_ENABLED == RTOS_CONFIG_TRUE)
+  vd_OSprof_init();
+#endif
 }
 
 /*************************************************************************/
@@ -200,7 +601,8 @@ void vd_OS_init(U4 numMsPeriod)
 /*                 U4 sizeOfStack:                                       */
 /*                       Size of task stack.                             */
 /*                 U1 priority:                                          */
-/*                       Unique priority level for task. 0 = highest.    */
+/*                       Unique priority level for task. 0 = highest,    */
+/*                       0xEF = lowest.                                  */
 /*                 U1 taskID:                                            */
 /*                       Task ID to refer to task when using APIs (cannot*/
 /*                       be changed). Value must be between 0 and the    */
@@ -213,125 +615,535 @@ U1 u1_OSsch_createTask(void (*newTaskFcn)(void), void* sp, U4 sizeOfStack, U1 pr
 {
   U1 u1_t_returnSts;
   
-  if(u1_s_numTasks >= (U1)SCH_MAX_NUM_TASKS)
-  {
-    u1_t_returnSts = (U1)SCH_TASK_CREATE_DENIED;
-  }
-  else if(Node_s_ap_mapTaskIDToTCB[taskID] != (void*)NULL)
+  /* Task IDs from SCH_BG_TASK_ID and priority levels of kernel tasks are reserved. */
+  if((taskID >= (U1)SCH_BG_TASK_ID) || SCH_APP_PRIORITY_INVALID(priority))
   {
     u1_t_returnSts = (U1)SCH_TASK_CREATE_DENIED;
   }
   else
   {
-    /* Map user configured task ID to the actual TCB location for later queries by user */
-    Node_s_ap_mapTaskIDToTCB[taskID] = &Node_s_as_listAllTasks[u1_s_numTasks];
-    
-    /* Set new task stack pointers */
-#if(RTOS_CONFIG_ENABLE_STACK_OVERFLOW_DETECT == RTOS_CONFIG_TRUE)   
-  #if(STACK_GROWTH == STACK_DESCENDING)
-    SchTask_s_as_taskList[u1_s_numTasks].topOfStack = ((OS_STACK*)sp - sizeOfStack + ONE);
-  #elif(STACK_GROWTH == STACK_ASCENDING)
-    SchTask_s_as_taskList[u1_s_numTasks].topOfStack = ((OS_STACK*)sp + sizeOfStack - ONE);
-  #else 
-    #error "STACK DIRECTION NOT PROPERLY DEFINED"
-  #endif /* STACK_GROWTH */
-    *SchTask_s_as_taskList[u1_s_numTasks].topOfStack = (OS_STACK)SCH_TOP_OF_STACK_MARK;
-#endif /* RTOS_CONFIG_ENABLE_STACK_OVERFLOW_DETECT */     
-    SchTask_s_as_taskList[u1_s_numTasks].stackPtr    =  sp_cpu_taskStackInit(newTaskFcn, (OS_STACK*)sp);
-    
-    /* Set new task priority, ID */
-    SchTask_s_as_taskList[u1_s_numTasks].priority = priority;
-    SchTask_s_as_taskList[u1_s_numTasks].taskID   = taskID;
-    
-    /* Set new linked list node content to newly formed TCB */
-    Node_s_as_listAllTasks[u1_s_numTasks].TCB = &SchTask_s_as_taskList[u1_s_numTasks];
-    
-    /* Put new task into ready queue sorted by priority */
-    vd_list_addTaskByPrio(&node_s_p_headOfReadyList, &Node_s_as_listAllTasks[u1_s_numTasks]);
-    
-    /* Increment number of tasks */
-    ++u1_s_numTasks;
-    
-    u1_t_returnSts = (U1)SCH_TASK_CREATE_SUCCESS;
+    u1_t_returnSts = u1_sch_taskCreate(newTaskFcn, sp, sizeOfStack, priority, priority, taskID, (U1)SCH_FALSE);
   }
   
   return (u1_t_returnSts);
 }
 
 /*************************************************************************/
-/*  Function Name: vd_OSsch_start                                        */
-/*  Purpose:       Give control to operating system.                     */
-/*  Arguments:     N/A                                                   */
-/*  Return:        N/A                                                   */
+/*  Function Name: u1_OSsch_createSharedStackTask                        */
+/*  Purpose:       Create run-to-completion task on a stack that may be  */
+/*                 shared with tasks it cannot preempt. Task is created  */
+/*                 suspended and runs from its start each time it is     */
+/*                 woken, until its routine returns.                     */
+/*  Arguments:     void* newTaskFcn:                                     */
+/*                       Function pointer to task routine.               */
+/*                 void* sp:                                             */
+/*                       Pointer to bottom of shared stack (highest mem. */
+/*                       address).                                       */
+/*                 U4 sizeOfStack:                                       */
+/*                       Size of shared stack.                           */
+/*                 U1 priority:                                          */
+/*                       Priority level for task. 0 = highest, 0xEF =    */
+/*                       lowest.                                         */
+/*                 U1 preemptThreshold:                                  */
+/*                       Only tasks of higher priority than this value   */
+/*                       may preempt task. Must not be below priority.   */
+/*                 U1 taskID:                                            */
+/*                       Task ID to refer to task when using APIs.       */
+/*                                                                       */
+/*  Return:        SCH_TASK_CREATE_SUCCESS   OR                          */
+/*                 SCH_TASK_CREATE_DENIED                                */
 /*************************************************************************/
-void vd_OSsch_start(void)
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_createSharedStackTask(void (*newTaskFcn)(void), void* sp, U4 sizeOfStack, U1 priority, U1 preemptThreshold, U1 taskID)
 {
-  /* Start at highest priority task */
-  tcb_g_p_nextTaskBlock = node_s_p_headOfReadyList->TCB;
+  U1 u1_t_returnSts;
   
-  OS_CPU_TRIGGER_DISPATCHER();
-  vd_cpu_enableInterruptsOSStart();
+  if((preemptThreshold > priority) || (taskID >= (U1)SCH_BG_TASK_ID) || SCH_APP_PRIORITY_INVALID(priority))
+  {
+    u1_t_returnSts = (U1)SCH_TASK_CREATE_DENIED;
+  }
+  else
+  {
+    u1_t_returnSts = u1_sch_taskCreate(newTaskFcn, sp, sizeOfStack, priority, preemptThreshold, taskID, (U1)SCH_TRUE);
+  }
+  
+  return (u1_t_returnSts);
 }
 
 /*************************************************************************/
-/*  Function Name: vd_OSsch_interruptEnter                               */
-/*  Purpose:       Must be called by ISRs external to OS at entry.       */
-/*  Arguments:     N/A                                                   */
-/*  Return:        N/A                                                   */
+/*  Function Name: u1_OSsch_setPreemptThreshold                          */
+/*  Purpose:       Set preemption threshold of task. Takes effect next   */
+/*                 time task is dispatched.                              */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*                 U1 preemptThreshold:                                  */
+/*                    Threshold priority. Must not be below priority of  */
+/*                    task.                                              */
+/*  Return:        SCH_SET_THRESHOLD_SUCCESS   OR                        */
+/*                 SCH_SET_THRESHOLD_DENIED                              */
 /*************************************************************************/
-U1 u1_OSsch_interruptEnter(void)
+U1 u1_OSsch_setPreemptThreshold(U1 taskID, U1 preemptThreshold)
 {
-#if(RTOS_CONFIG_PRESLEEP_FUNC == RTOS_CONFIG_TRUE)
-  if(u1_s_sleepState == (U1)SCH_CPU_SLEEPING)
-  {  
-    /* Post-sleep hook function defined by application */
-    app_OSPostSleepFcn();
+  U1        u1_t_returnSts;
+  Sch_Task* tcb_t_p_task;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u1_t_returnSts = (U1)SCH_SET_THRESHOLD_DENIED;
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  if((taskID < (U1)SCH_BG_TASK_ID) && (Node_s_ap_mapTaskIDToTCB[taskID] != (ListNode*)NULL))
+  {
+    tcb_t_p_task = Node_s_ap_mapTaskIDToTCB[taskID]->TCB;
     
-    u1_s_sleepState = (U1)SCH_CPU_NOT_SLEEPING;
+    /* Compare against priority task was created with if it is currently raised. */
+    if(tcb_t_p_task->basePriority != (U1)SCH_TASK_PRIORITY_UNDEFINED)
+    {
+      if(preemptThreshold <= tcb_t_p_task->basePriority)
+      {
+        tcb_t_p_task->preemptThreshold = preemptThreshold;
+        u1_t_returnSts                 = (U1)SCH_SET_THRESHOLD_SUCCESS;
+      }
+      else{}
+    }
+    else if(preemptThreshold <= tcb_t_p_task->priority)
+    {
+      tcb_t_p_task->preemptThreshold = preemptThreshold;
+      u1_t_returnSts                 = (U1)SCH_SET_THRESHOLD_SUCCESS;
+    }
+    else{}
   }
-#endif
+  else{}
   
-  return (u1_OSsch_maskInterrupts());
-}  
+  OS_CPU_EXIT_CRITICAL();
   
-/*************************************************************************/
-/*  Function Name: vd_OSsch_interruptExit                                */
-/*  Purpose:       Must be called by ISRs external to OS at exit.        */
-/*  Arguments:     U1 prioMaskReset:                                     */
-/*                    Priority mask returned by u1_OSsch_interruptEnter()*/
-/*  Return:        N/A                                                   */
-/*************************************************************************/
-void vd_OSsch_interruptExit(U1 prioMaskReset)
-{
-  vd_OSsch_unmaskInterrupts(prioMaskReset);
+  return (u1_t_returnSts);
 }
+#endif
 
 /*************************************************************************/
-/*  Function Name: u1_OSsch_g_numTasks                                   */
-/*  Purpose:       Return current number of scheduled tasks.             */
-/*  Arguments:     N/A                                                   */
-/*  Return:        Number of tasks: 0 - SCH_MAX_NUM_TASKS                */
+/*  Function Name: u1_OSsch_createPeriodicTask                           */
+/*  Purpose:       Create task that is released by the kernel every      */
+/*                 period.                                               */
+/*  Arguments:     void* newTaskFcn, void* sp, U4 sizeOfStack,           */
+/*                 U1 priority, U1 taskID:                               */
+/*                       Same as u1_OSsch_createTask().                  */
+/*                 U4 period:                                            */
+/*                       Release period in ticks.                        */
+/*                 U4 phase:                                             */
+/*                       Ticks from creation to first release.           */
+/*                 U4 relativeDeadline:                                  */
+/*                       Deadline in ticks after each release. If zero,  */
+/*                       deadline is equal to period.                    */
+/*                                                                       */
+/*  Return:        SCH_TASK_CREATE_SUCCESS   OR                          */
+/*                 SCH_TASK_CREATE_DENIED                                */
 /*************************************************************************/
-U1 u1_OSsch_g_numTasks(void)
+#if(RTOS_CONFIG_ENABLE_PERIODIC_TASKS == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_createPeriodicTask(void (*newTaskFcn)(void), void* sp, U4 sizeOfStack, U1 priority, U1 taskID, U4 period, U4 phase, U4 relativeDeadline)
 {
-  return (u1_s_numTasks);
+  U1            u1_t_returnSts;
+  U1            u1_t_osRunning;
+  Sch_Periodic* per_t_p_periodic;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  /* Only constrained deadlines (deadline <= period) are supported. */
+  if((period == (U4)ZERO) || (relativeDeadline > period) || (taskID >= (U1)SCH_BG_TASK_ID))
+  {
+    u1_t_returnSts = (U1)SCH_TASK_CREATE_DENIED;
+  }
+  else
+  {
+    /* New task may preempt caller, so release parameters are set before it can run. */
+    u1_t_osRunning = (U1)(tcb_g_p_currentTaskBlock != (Sch_Task*)SCH_TCB_PTR_INIT);
+    
+    if(u1_t_osRunning)
+    {
+      OS_CPU_ENTER_CRITICAL();
+    }
+    else{}
+    
+    u1_t_returnSts = u1_OSsch_createTask(newTaskFcn, sp, sizeOfStack, priority, taskID);
+    
+    if(u1_t_returnSts == (U1)SCH_TASK_CREATE_SUCCESS)
+    {
+      per_t_p_periodic              = &(Node_s_ap_mapTaskIDToTCB[taskID]->TCB->periodic);
+      per_t_p_periodic->period      = period;
+      per_t_p_periodic->relDeadline = (relativeDeadline == (U4)ZERO) ? period : relativeDeadline;
+      per_t_p_periodic->nextRelease = u4_s_tickCntr + phase;
+      per_t_p_periodic->releaseTick = per_t_p_periodic->nextRelease;
+      per_t_p_periodic->jobActive   = (U1)SCH_FALSE;
+      
+      vd_sch_periodicStatsClear(per_t_p_periodic);
+    }
+    else{}
+    
+    if(u1_t_osRunning)
+    {
+      OS_CPU_EXIT_CRITICAL();
+    }
+    else{}
+  }
+  
+  return (u1_t_returnSts);
 }
+#endif
 
 /*************************************************************************/
-/*  Function Name: u4_OSsch_getCurrentTickPeriodMs                       */
-/*  Purpose:       Get current period in ms for scheduler tick.          */
-/*  Arguments:     N/A                                                   */
-/*  Return:        Tick rate in milliseconds.                            */
+/*  Function Name: u1_sch_taskCreate                                     */
+/*  Purpose:       Create new task in list.                              */
+/*  Arguments:     See u1_OSsch_createSharedStackTask().                 */
+/*                 U1 sharedStack:                                       */
+/*                       Task runs to completion on a shared stack.      */
+/*                       Ignored if preemption threshold is disabled.    */
+/*  Return:        SCH_TASK_CREATE_SUCCESS   OR                          */
+/*                 SCH_TASK_CREATE_DENIED                                */
 /*************************************************************************/
-U4 u4_OSsch_getCurrentTickPeriodMs(void)
+static U1 u1_sch_taskCreate(void (*newTaskFcn)(void), void* sp, U4 sizeOfStack, U1 priority, U1 preemptThreshold, U1 taskID, U1 sharedStack)
 {
-  return (u4_cpu_getCurrentMsPeriod());
-}
-
-/*************************************************************************/
-/*  Function Name: u1_OSsch_getReasonForWakeup                           */
-/*  Purpose:       Get most recent reason that current task has woken up.*/
-/*  Arguments:     N/A                                                   */
+  U1 u1_t_returnSts;
+  U1 u1_t_slot;
+  U1 u1_t_osRunning;
+#if(RTOS_CONFIG_ENABLE_STACK_WATERMARK == RTOS_CONFIG_TRUE)
+  U4 u4_t_word;
+#endif
+  OS_CPU_CRITICAL_ALLOC();
+  
+  /* Interrupts are held off by vd_OS_init() until OS starts. Only lock out other tasks once running. */
+  u1_t_osRunning = (U1)(tcb_g_p_currentTaskBlock != (Sch_Task*)SCH_TCB_PTR_INIT);
+  
+  if(u1_t_osRunning)
+  {
+    OS_CPU_ENTER_CRITICAL();
+  }
+  else{}
+  
+  if(u1_s_numTasks >= (U1)SCH_MAX_NUM_TASKS)
+  {
+    u1_t_returnSts = (U1)SCH_TASK_CREATE_DENIED;
+  }
+  else if(taskID >= (U1)SCH_MAX_NUM_TASKS)
+  {
+    u1_t_returnSts = (U1)SCH_TASK_CREATE_DENIED;
+  }
+  else if(Node_s_ap_mapTaskIDToTCB[taskID] != (void*)NULL)
+  {
+    u1_t_returnSts = (U1)SCH_TASK_CREATE_DENIED;
+  }
+  else
+  {
+    /* Take first free TCB slot */
+    u1_t_slot = u1_sch_allocTaskSlot();
+    
+    /* Map user configured task ID to the actual TCB location for later queries by user */
+    Node_s_ap_mapTaskIDToTCB[taskID] = &Node_s_as_listAllTasks[u1_t_slot];
+    
+    /* Set new task stack pointers */
+#if(RTOS_CONFIG_ENABLE_STACK_OVERFLOW_DETECT == RTOS_CONFIG_TRUE)   
+  #if(STACK_GROWTH == STACK_DESCENDING)
+    SchTask_s_as_taskList[u1_t_slot].topOfStack = ((OS_STACK*)sp - sizeOfStack + ONE);
+  #elif(STACK_GROWTH == STACK_ASCENDING)
+    SchTask_s_as_taskList[u1_t_slot].topOfStack = ((OS_STACK*)sp + sizeOfStack - ONE);
+  #else 
+    #error "STACK DIRECTION NOT PROPERLY DEFINED"
+  #endif /* STACK_GROWTH */
+  #if(SCH_STACK_LIMIT_MARK == RTOS_CONFIG_TRUE)
+    *SchTask_s_as_taskList[u1_t_slot].topOfStack = (OS_STACK)SCH_TOP_OF_STACK_MARK;
+  #endif
+#endif /* RTOS_CONFIG_ENABLE_STACK_OVERFLOW_DETECT */     
+#if(RTOS_CONFIG_ENABLE_STACK_WATERMARK == RTOS_CONFIG_TRUE)
+    SchTask_s_as_taskList[u1_t_slot].stackSize    = sizeOfStack;
+    SchTask_s_as_taskList[u1_t_slot].stackMinFree = sizeOfStack;
+    
+    /* Paint whole stack. A shared stack may be in use by another task once OS is running. */
+    if(!(sharedStack && u1_t_osRunning))
+    {
+      for(u4_t_word = (U4)ZERO; u4_t_word < sizeOfStack; u4_t_word++)
+      {
+        SCH_STACK_WORD_FROM_END(&SchTask_s_as_taskList[u1_t_slot], u4_t_word) = (OS_STACK)SCH_TOP_OF_STACK_MARK;
+      }
+    }
+    else{}
+#endif
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+    /* Shared stack may be in use by another task. Stack frame is built when task is dispatched. */
+    if(sharedStack)
+    {
+      SchTask_s_as_taskList[u1_t_slot].stackPtr  = (OS_STACK*)NULL;
+    }
+    else
+#endif
+    {
+      SchTask_s_as_taskList[u1_t_slot].stackPtr  =  sp_cpu_taskStackInit(newTaskFcn, (OS_STACK*)sp, &vd_sch_taskReturn);
+    }
+    
+    /* Keep entry point and stack base so that task can be restarted */
+    SchTask_s_as_taskList[u1_t_slot].taskFcn     = newTaskFcn;
+    SchTask_s_as_taskList[u1_t_slot].stackBase   = (OS_STACK*)sp;
+    
+    /* Set new task priority, ID */
+    SchTask_s_as_taskList[u1_t_slot].priority = priority;
+    SchTask_s_as_taskList[u1_t_slot].taskID   = taskID;
+#if(RTOS_CONFIG_ENABLE_DYNAMIC_PRIORITY == RTOS_CONFIG_TRUE)
+    SchTask_s_as_taskList[u1_t_slot].assignedPriority = priority;
+#endif
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+    SchTask_s_as_taskList[u1_t_slot].preemptThreshold = preemptThreshold;
+    SchTask_s_as_taskList[u1_t_slot].basePriority     = (U1)SCH_TASK_PRIORITY_UNDEFINED;
+    SchTask_s_as_taskList[u1_t_slot].sharedStack      = sharedStack;
+#endif
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+    SchTask_s_as_taskList[u1_t_slot].partition          = (U1)SCH_NO_PARTITION;
+    SchTask_s_as_taskList[u1_t_slot].throttled          = (U1)SCH_FALSE;
+    SchTask_s_as_taskList[u1_t_slot].partitionNext      = (Sch_Task*)NULL;
+#endif
+#if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+    SchTask_s_as_taskList[u1_t_slot].tableWait          = (U1)SCH_FALSE;
+#endif
+#if(RTOS_CONFIG_ENABLE_PERIODIC_TASKS == RTOS_CONFIG_TRUE)
+    /* Slot may have been used by a deleted periodic task. */
+    SchTask_s_as_taskList[u1_t_slot].periodic.period    = (U4)ZERO;
+    SchTask_s_as_taskList[u1_t_slot].periodic.jobActive = (U1)SCH_FALSE;
+#endif
+    
+    /* Set new linked list node content to newly formed TCB */
+    Node_s_as_listAllTasks[u1_t_slot].TCB = &SchTask_s_as_taskList[u1_t_slot];
+    
+    /* Increment number of tasks */
+    ++u1_s_numTasks;
+    
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+    /* Run-to-completion task waits in suspend list until it is activated. */
+    if(sharedStack)
+    {
+      SchTask_s_as_taskList[u1_t_slot].flags |= (U1)SCH_TASK_FLAG_STS_SUSPENDED;
+      vd_list_addNodeToFront(&node_s_p_headOfSuspendList, &Node_s_as_listAllTasks[u1_t_slot]);
+    }
+    else
+#endif
+    {
+      /* Put new task into ready queue at its priority level */
+      vd_sch_readyQueueInsert(&Node_s_as_listAllTasks[u1_t_slot]);
+      
+      /* Task created from a running task may preempt it */
+      if(u1_t_osRunning && (tcb_sch_readyQueueHighest() != tcb_g_p_currentTaskBlock))
+      {
+        tcb_g_p_nextTaskBlock = tcb_sch_readyQueueHighest();
+        
+        vd_sch_requestDispatch();
+      }
+      else{}
+    }
+    
+    u1_t_returnSts = (U1)SCH_TASK_CREATE_SUCCESS;
+  }
+  
+  if(u1_t_osRunning)
+  {
+    OS_CPU_EXIT_CRITICAL();
+  }
+  else{}
+  
+  return (u1_t_returnSts);
+}
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_scheduleTableStart                           */
+/*  Purpose:       Start releasing tasks from a static schedule table.   */
+/*                 First hyperperiod starts on the next tick.            */
+/*  Arguments:     const OSScheduleEntry* table:                         */
+/*                    Entries sorted by offset.                          */
+/*                 U1 numEntries:                                        */
+/*                    Number of entries in table.                        */
+/*                 U4 hyperperiod:                                       */
+/*                    Table length in ticks.                             */
+/*  Return:        SCH_TABLE_START_SUCCESS   OR                          */
+/*                 SCH_TABLE_START_DENIED                                */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_scheduleTableStart(const OSScheduleEntry* table, U1 numEntries, U4 hyperperiod)
+{
+  U1 u1_t_returnSts;
+  U1 u1_t_index;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u1_t_returnSts = (U1)SCH_TABLE_START_SUCCESS;
+  
+  if((table == (const OSScheduleEntry*)NULL) || (numEntries == (U1)ZERO) || (hyperperiod == (U4)ZERO))
+  {
+    u1_t_returnSts = (U1)SCH_TABLE_START_DENIED;
+  }
+  else
+  {
+    /* Check table once here so that tick handling only compares offsets. */
+    for(u1_t_index = (U1)ZERO; u1_t_index < numEntries; u1_t_index++)
+    {
+      if((table[u1_t_index].offset >= hyperperiod) || 
+         (table[u1_t_index].taskID >= (U1)SCH_BG_TASK_ID) ||
+         ((u1_t_index != (U1)ZERO) && (table[u1_t_index].offset < table[u1_t_index - ONE].offset)))
+      {
+        u1_t_returnSts = (U1)SCH_TABLE_START_DENIED;
+      }
+      else{}
+    }
+  }
+  
+  if(u1_t_returnSts == (U1)SCH_TABLE_START_SUCCESS)
+  {
+    OS_CPU_ENTER_CRITICAL();
+    
+    Entry_s_p_scheduleTable = table;
+    u1_s_tableNumEntries    = numEntries;
+    u1_s_tableIndex         = (U1)ZERO;
+    u4_s_tableHyperperiod   = hyperperiod;
+    u4_s_tableTick          = (U4)ZERO;
+    u4_s_tableOverruns      = (U4)ZERO;
+    
+    OS_CPU_EXIT_CRITICAL();
+  }
+  else{}
+  
+  return (u1_t_returnSts);
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_scheduleTableStop                            */
+/*  Purpose:       Stop releasing tasks from schedule table.             */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_scheduleTableStop(void)
+{
+  OS_CPU_CRITICAL_ALLOC();
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  Entry_s_p_scheduleTable = (const OSScheduleEntry*)NULL;
+  
+  OS_CPU_EXIT_CRITICAL();
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_scheduleTableWait                            */
+/*  Purpose:       Suspend current table task until its next release.    */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_scheduleTableWait(void)
+{
+  OS_CPU_CRITICAL_ALLOC();
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  vd_sch_taskSuspend(Node_s_ap_mapTaskIDToTCB[tcb_g_p_currentTaskBlock->taskID]);
+  tcb_g_p_currentTaskBlock->tableWait = (U1)SCH_TRUE;
+  
+  OS_CPU_EXIT_CRITICAL();
+}
+
+/*************************************************************************/
+/*  Function Name: u4_OSsch_scheduleTableGetOverruns                     */
+/*  Purpose:       Number of table releases of a task that had not yet   */
+/*                 finished its previous release.                        */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U4: Number of missed releases since table started.    */
+/*************************************************************************/
+U4 u4_OSsch_scheduleTableGetOverruns(void)
+{
+  return (u4_s_tableOverruns);
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_start                                        */
+/*  Purpose:       Give control to operating system.                     */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_start(void)
+{
+  /* Start at highest priority task */
+  tcb_g_p_nextTaskBlock = tcb_sch_readyQueueHighest();
+  
+#if(RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE)
+  /* Run-time accounting starts with first dispatch. */
+  u4_s_lastSwitchCycles      = OS_CPU_GET_CYCLE_COUNT();
+  u4_s_loadWindowStartCycles = u4_s_lastSwitchCycles;
+  u4_s_burstCycles           = (U4)ZERO;
+  u4_s_loadWindowTicks       = (U4)ZERO;
+#endif
+  
+  OS_CPU_TRIGGER_DISPATCHER();
+  vd_cpu_enableInterruptsOSStart();
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_interruptEnter                               */
+/*  Purpose:       Must be called by ISRs external to OS at entry.       */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+U1 u1_OSsch_interruptEnter(void)
+{
+#if(RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE)
+  vd_OStrace_record((U1)TRACE_EVT_ISR_ENTER, (tcb_g_p_currentTaskBlock != (Sch_Task*)SCH_TCB_PTR_INIT) ? tcb_g_p_currentTaskBlock->taskID : (U1)TRACE_TASK_ID_NONE, OS_CPU_GET_EXCEPTION_NUMBER());
+#endif
+  
+#if(RTOS_CONFIG_PRESLEEP_FUNC == RTOS_CONFIG_TRUE)
+  if(u1_s_sleepState == (U1)SCH_CPU_SLEEPING)
+  {  
+    /* Post-sleep hook function defined by application */
+    app_OSPostSleepFcn();
+    
+    u1_s_sleepState = (U1)SCH_CPU_NOT_SLEEPING;
+  }
+#endif
+  
+  return (u1_OSsch_maskInterrupts());
+}  
+  
+/*************************************************************************/
+/*  Function Name: vd_OSsch_interruptExit                                */
+/*  Purpose:       Must be called by ISRs external to OS at exit.        */
+/*  Arguments:     U1 prioMaskReset:                                     */
+/*                    Priority mask returned by u1_OSsch_interruptEnter()*/
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_interruptExit(U1 prioMaskReset)
+{
+#if(RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE)
+  vd_OStrace_record((U1)TRACE_EVT_ISR_EXIT, (tcb_g_p_currentTaskBlock != (Sch_Task*)SCH_TCB_PTR_INIT) ? tcb_g_p_currentTaskBlock->taskID : (U1)TRACE_TASK_ID_NONE, OS_CPU_GET_EXCEPTION_NUMBER());
+#endif
+  
+  vd_OSsch_unmaskInterrupts(prioMaskReset);
+}
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_g_numTasks                                   */
+/*  Purpose:       Return current number of scheduled tasks.             */
+/*  Arguments:     N/A                                                   */
+/*  Return:        Number of tasks: 0 - SCH_MAX_NUM_TASKS                */
+/*************************************************************************/
+U1 u1_OSsch_g_numTasks(void)
+{
+  return (u1_s_numTasks);
+}
+
+/*************************************************************************/
+/*  Function Name: u4_OSsch_getCurrentTickPeriodMs                       */
+/*  Purpose:       Get current period in ms for scheduler tick.          */
+/*  Arguments:     N/A                                                   */
+/*  Return:        Tick rate in milliseconds.                            */
+/*************************************************************************/
+U4 u4_OSsch_getCurrentTickPeriodMs(void)
+{
+  return (u4_cpu_getCurrentMsPeriod());
+}
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_getReasonForWakeup                           */
+/*  Purpose:       Get most recent reason that current task has woken up.*/
+/*  Arguments:     N/A                                                   */
 /*  Return:        SCH_TASK_WAKEUP_SLEEP_TIMEOUT          OR             */
 /*                 SCH_TASK_NO_WAKEUP_SINCE_LAST_CHECK    OR             */
 /*                 SCH_TASK_WAKEUP_MBOX_READY             OR             */
@@ -344,6 +1156,7 @@ U4 u4_OSsch_getCurrentTickPeriodMs(void)
 U1 u1_OSsch_getReasonForWakeup(void)
 {
   U1 u1_t_reason;
+  OS_CPU_CRITICAL_ALLOC();
   
   /* Don't let scheduler interrupt itself. Ticker keeps ticking. */
   OS_CPU_ENTER_CRITICAL();
@@ -368,6 +1181,29 @@ U4 u4_OSsch_getTicks(void)
   return(u4_s_tickCntr);
 }
 
+/*************************************************************************/
+/*  Function Name: u8_OSsch_getTicks64                                   */
+/*  Purpose:       Get 64-bit number of ticks from scheduler. Does not   */
+/*                 overflow in practice. Safe to call from any context.  */
+/*  Arguments:     N/A                                                   */
+/*  Return:        Number of scheduler ticks since OS init.              */
+/*************************************************************************/
+U8 u8_OSsch_getTicks64(void)
+{
+  U4 u4_t_high;
+  U4 u4_t_low;
+  
+  /* Read again if tick interrupt carried into high word between the two reads. */
+  do
+  {
+    u4_t_high = u4_s_tickCntrHigh;
+    u4_t_low  = u4_s_tickCntr;
+  }
+  while(u4_t_high != u4_s_tickCntrHigh);
+  
+  return((((U8)u4_t_high) << 32) | (U8)u4_t_low);
+}
+
 /*************************************************************************/
 /*  Function Name: u1_OSsch_getCurrentTaskID                             */
 /*  Purpose:       Returns current task ID.                              */
@@ -391,556 +1227,3749 @@ U1 u1_OSsch_getCurrentTaskPrio(void)
 }
 
 /*************************************************************************/
-/*  Function Name: u1_OSsch_getCPULoad                                   */
-/*  Purpose:       Returns CPU load averaged over 100 ticks.             */
-/*  Arguments:     N/A                                                   */
-/*  Return:        U1: CPU load as a percentage.                         */
+/*  Function Name: u1_OSsch_idleJobPost                                  */
+/*  Purpose:       Queue job to be run by background task.               */
+/*  Arguments:     OSIdleJob* job:                                       */
+/*                    Job storage.                                       */
+/*                 U1 (*step)(void* arg):                                */
+/*                    Step function.                                     */
+/*                 void* arg:                                            */
+/*                    Passed to step function.                           */
+/*  Return:        SCH_IDLE_JOB_POST_SUCCESS   OR                        */
+/*                 SCH_IDLE_JOB_POST_DENIED                              */
 /*************************************************************************/
-#if (RTOS_CONFIG_CALC_TASK_CPU_LOAD == RTOS_CONFIG_TRUE)
-U1 u1_OSsch_getCPULoad(void)
+#if(RTOS_CONFIG_ENABLE_IDLE_JOBS == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_idleJobPost(OSIdleJob* job, U1 (*step)(void* arg), void* arg)
 {
-  return ((U1)SCH_ONE_HUNDRED_PERCENT - OS_s_cpuData.CPUIdlePercent.CPU_idleAvg);
+  U1 u1_t_returnSts;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u1_t_returnSts = (U1)SCH_IDLE_JOB_POST_DENIED;
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  if((job != (OSIdleJob*)NULL) && (step != (U1 (*)(void*))NULL) && (job->queued == (U1)SCH_FALSE))
+  {
+    job->step   = step;
+    job->arg    = arg;
+    job->next   = (OSIdleJob*)NULL;
+    job->queued = (U1)SCH_TRUE;
+    
+    if(Job_s_p_idleJobHead == (OSIdleJob*)NULL)
+    {
+      Job_s_p_idleJobHead = job;
+    }
+    else
+    {
+      Job_s_p_idleJobTail->next = job;
+    }
+    
+    Job_s_p_idleJobTail = job;
+    u1_t_returnSts      = (U1)SCH_IDLE_JOB_POST_SUCCESS;
+  }
+  else{}
+  
+  OS_CPU_EXIT_CRITICAL();
+  
+  return (u1_t_returnSts);
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_idleRegisterSleepState                       */
+/*  Purpose:       Register sleep state with idle governor.              */
+/*  Arguments:     U1 stateID:                                           */
+/*                    Index of state.                                    */
+/*                 U4 latencyUs:                                         */
+/*                    Entry plus exit latency in microseconds.           */
+/*                 U4 powerCost:                                         */
+/*                    Relative power while in state.                     */
+/*  Return:        SCH_SLEEP_STATE_SUCCESS   OR                          */
+/*                 SCH_SLEEP_STATE_DENIED                                */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_IDLE_GOVERNOR == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_idleRegisterSleepState(U1 stateID, U4 latencyUs, U4 powerCost)
+{
+  U1 u1_t_returnSts;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u1_t_returnSts = (U1)SCH_SLEEP_STATE_DENIED;
+  
+  if(stateID < (U1)SCH_NUM_SLEEP_STATES)
+  {
+    OS_CPU_ENTER_CRITICAL();
+    
+    SleepState_s_as_states[stateID].latencyUs  = latencyUs;
+    SleepState_s_as_states[stateID].powerCost  = powerCost;
+    SleepState_s_as_states[stateID].registered = (U1)SCH_TRUE;
+    
+    OS_CPU_EXIT_CRITICAL();
+    
+    u1_t_returnSts = (U1)SCH_SLEEP_STATE_SUCCESS;
+  }
+  else{}
+  
+  return (u1_t_returnSts);
+}
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_idleGetSleepState                            */
+/*  Purpose:       Return sleep state chosen for current idle period.    */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U1: State ID   OR                                     */
+/*                 SCH_SLEEP_STATE_NONE                                  */
+/*************************************************************************/
+U1 u1_OSsch_idleGetSleepState(void)
+{
+  return (u1_s_idleSleepState);
+}
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_idleGetSleepStats                            */
+/*  Purpose:       Copy statistics of sleep state.                       */
+/*  Arguments:     U1 stateID:                                           */
+/*                    Index of state.                                    */
+/*                 OSSleepStateStats* stats:                             */
+/*                    Structure to copy statistics to.                   */
+/*  Return:        SCH_SLEEP_STATE_SUCCESS   OR                          */
+/*                 SCH_SLEEP_STATE_DENIED                                */
+/*************************************************************************/
+U1 u1_OSsch_idleGetSleepStats(U1 stateID, OSSleepStateStats* stats)
+{
+  U1 u1_t_returnSts;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u1_t_returnSts = (U1)SCH_SLEEP_STATE_DENIED;
+  
+  if((stateID < (U1)SCH_NUM_SLEEP_STATES) && (stats != (OSSleepStateStats*)NULL))
+  {
+    OS_CPU_ENTER_CRITICAL();
+    
+    stats->entries        = SleepState_s_as_states[stateID].entries;
+    stats->residencyTicks = SleepState_s_as_states[stateID].residencyTicks;
+    stats->tooDeep        = SleepState_s_as_states[stateID].tooDeep;
+    stats->tooShallow     = SleepState_s_as_states[stateID].tooShallow;
+    
+    OS_CPU_EXIT_CRITICAL();
+    
+    u1_t_returnSts = (U1)SCH_SLEEP_STATE_SUCCESS;
+  }
+  else{}
+  
+  return (u1_t_returnSts);
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_getCPULoad                                   */
+/*  Purpose:       Returns CPU load averaged over 100 ticks.             */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U1: CPU load as a percentage.                         */
+/*************************************************************************/
+#if (RTOS_CONFIG_CALC_TASK_CPU_LOAD == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_getCPULoad(void)
+{
+  return ((U1)SCH_ONE_HUNDRED_PERCENT - OS_s_cpuData.CPUIdlePercent.CPU_idleAvg);
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: u8_OSsch_getTaskRunCycles                             */
+/*  Purpose:       Returns total CPU cycles a task has run for.          */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*  Return:        U8: Number of CPU cycles. Zero if ID is not valid.    */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE)
+U8 u8_OSsch_getTaskRunCycles(U1 taskID)
+{
+  U8 u8_t_cycles;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u8_t_cycles = (U8)ZERO;
+  
+  if((taskID < (U1)SCH_MAX_NUM_TASKS) && (Node_s_ap_mapTaskIDToTCB[taskID] != (ListNode*)NULL))
+  {
+    /* 64-bit read is not atomic. */
+    OS_CPU_ENTER_CRITICAL();
+    
+    /* Include time of current burst if task is running. */
+    if(Node_s_ap_mapTaskIDToTCB[taskID]->TCB == tcb_g_p_currentTaskBlock)
+    {
+      vd_sch_runTimeAccount();
+    }
+    else{}
+    
+    u8_t_cycles = Node_s_ap_mapTaskIDToTCB[taskID]->TCB->runCycles;
+    
+    OS_CPU_EXIT_CRITICAL();
+  }
+  else{}
+  
+  return (u8_t_cycles);
+}
+
+/*************************************************************************/
+/*  Function Name: u4_OSsch_getTaskMaxBurst                              */
+/*  Purpose:       Returns longest time a task has run without being     */
+/*                 switched out.                                         */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*  Return:        U4: Number of CPU cycles. Zero if ID is not valid.    */
+/*************************************************************************/
+U4 u4_OSsch_getTaskMaxBurst(U1 taskID)
+{
+  U4 u4_t_cycles;
+  
+  u4_t_cycles = (U4)ZERO;
+  
+  if((taskID < (U1)SCH_MAX_NUM_TASKS) && (Node_s_ap_mapTaskIDToTCB[taskID] != (ListNode*)NULL))
+  {
+    u4_t_cycles = Node_s_ap_mapTaskIDToTCB[taskID]->TCB->maxBurstCycles;
+  }
+  else{}
+  
+  return (u4_t_cycles);
+}
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_getTaskLoad                                  */
+/*  Purpose:       Returns CPU load of a task over the last 100 ticks.   */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*  Return:        U1: CPU load as a percentage. Zero if ID is not valid.*/
+/*************************************************************************/
+U1 u1_OSsch_getTaskLoad(U1 taskID)
+{
+  U1 u1_t_load;
+  
+  u1_t_load = (U1)ZERO;
+  
+  if((taskID < (U1)SCH_MAX_NUM_TASKS) && (Node_s_ap_mapTaskIDToTCB[taskID] != (ListNode*)NULL))
+  {
+    u1_t_load = Node_s_ap_mapTaskIDToTCB[taskID]->TCB->loadPercent;
+  }
+  else{}
+  
+  return (u1_t_load);
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: u4_OSsch_getTaskStackMinFree                          */
+/*  Purpose:       Returns fewest unused stack words measured for a task */
+/*                 since it was created.                                 */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*  Return:        U4: Number of stack words. Zero if ID is not valid.   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_STACK_WATERMARK == RTOS_CONFIG_TRUE)
+U4 u4_OSsch_getTaskStackMinFree(U1 taskID)
+{
+  U4 u4_t_minFree;
+  
+  u4_t_minFree = (U4)ZERO;
+  
+  if((taskID < (U1)SCH_MAX_NUM_TASKS) && (Node_s_ap_mapTaskIDToTCB[taskID] != (ListNode*)NULL))
+  {
+    u4_t_minFree = Node_s_ap_mapTaskIDToTCB[taskID]->TCB->stackMinFree;
+  }
+  else{}
+  
+  return (u4_t_minFree);
+}
+
+/*************************************************************************/
+/*  Function Name: u4_OSsch_getBackgroundStackMinFree                    */
+/*  Purpose:       Returns fewest unused stack words measured for the    */
+/*                 background task.                                      */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U4: Number of stack words.                            */
+/*************************************************************************/
+U4 u4_OSsch_getBackgroundStackMinFree(void)
+{
+  return (u4_OSsch_getTaskStackMinFree((U1)SCH_BG_TASK_ID));
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_dispatchHook                                 */
+/*  Purpose:       Called by dispatcher with interrupts disabled after   */
+/*                 context of current task is saved and before context   */
+/*                 of next task is restored.                             */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if((RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE) || (RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE) || \
+    (RTOS_CONFIG_ENABLE_MPU_STACK_GUARD == RTOS_CONFIG_TRUE) || (RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE))
+void vd_OSsch_dispatchHook(void)
+{
+#if(RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE)
+  vd_OStrace_record((U1)TRACE_EVT_TASK_SWITCH, (tcb_g_p_currentTaskBlock != (Sch_Task*)SCH_TCB_PTR_INIT) ? tcb_g_p_currentTaskBlock->taskID : (U1)TRACE_TASK_ID_NONE, tcb_g_p_nextTaskBlock->taskID);
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE)
+  /* Charge cycles since last switch to outgoing task. */
+  vd_sch_runTimeAccount();
+  
+  /* Burst ends only if a different task is switched in. */
+  if(tcb_g_p_nextTaskBlock != tcb_g_p_currentTaskBlock)
+  {
+    if((tcb_g_p_currentTaskBlock != (Sch_Task*)NULL) && (u4_s_burstCycles > tcb_g_p_currentTaskBlock->maxBurstCycles))
+    {
+      tcb_g_p_currentTaskBlock->maxBurstCycles = u4_s_burstCycles;
+    }
+    else{}
+    
+    u4_s_burstCycles = (U4)ZERO;
+  }
+  else{}
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+  /* Task entering run state is raised to its preemption threshold. */
+  vd_sch_thresholdRaise(Node_s_ap_mapTaskIDToTCB[tcb_g_p_nextTaskBlock->taskID]);
+  
+  /* Run-to-completion task starts from its entry point. No other task of its group can be using the shared stack now. */
+  if(tcb_g_p_nextTaskBlock->stackPtr == (OS_STACK*)NULL)
+  {
+    tcb_g_p_nextTaskBlock->stackPtr = sp_cpu_taskStackInit(tcb_g_p_nextTaskBlock->taskFcn, tcb_g_p_nextTaskBlock->stackBase, &vd_sch_taskReturn);
+  }
+  else{}
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_MPU_STACK_GUARD == RTOS_CONFIG_TRUE)
+  /* Guard moves last. Rest of dispatcher only reads outgoing task stack. */
+  OS_CPU_STACK_GUARD_SET(tcb_g_p_nextTaskBlock->topOfStack);
+#endif
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_setNewTickPeriod                             */
+/*  Purpose:       Set new tick period in milliseconds.                  */
+/*  Arguments:     U4 numMsReload:                                       */
+/*                    Period of interrupts.                              */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_setNewTickPeriod(U4 numMsReload)
+{
+  vd_cpu_setNewSchedPeriod(numMsReload);
+  
+#if(RTOS_CONFIG_ENABLE_IDLE_GOVERNOR == RTOS_CONFIG_TRUE)
+  u4_s_tickPeriodUs = numMsReload * (U4)SCH_US_PER_MS;
+#endif
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_setReasonForWakeup                           */
+/*  Purpose:       Set reason for wakeup to resource available. Called   */
+/*                 internal to RTOS by other RTOS modules. It is expected*/
+/*                 that OS internal modules will call taskWake() *after* */
+/*                 this function call and maintain their own block lists.*/
+/*  Arguments:     U1 reason:                                            */
+/*                    Identifier code for wakeup reason.                 */
+/*                 Sch_Task* wakeupTaskTCB:                              */
+/*                    Pointer to task TCB that is being woken up which   */
+/*                    was stored on resource blocked list.               */
+/*  Return:        void                                                  */
+/*************************************************************************/
+void vd_OSsch_setReasonForWakeup(U1 reason, struct Sch_Task* wakeupTaskTCB)
+{
+  OS_CPU_CRITICAL_ALLOC();
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  /* Clear OS resource pointer. */
+  wakeupTaskTCB->resource = (void*)NULL;
+  
+  /* Remove sleep reason from flags entry in TCB */
+  wakeupTaskTCB->flags &= ~((U1)reason);
+  
+  /* Set the wakeup reason for application to read. */
+  wakeupTaskTCB->wakeReason = reason;
+  
+  OS_CPU_EXIT_CRITICAL();
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_setReasonForSleep                            */
+/*  Purpose:       Set reason for task sleep according to mask and set   */
+/*                 task to sleep state.                                  */
+/*  Arguments:     void* taskSleepResource:                              */
+/*                       Address of resource task is blocked on.         */
+/*                 U1 resourceType:                                      */
+/*                       Code for resource that task is sleeping on.     */
+/*                 U4 period:                                            */
+/*                       Period to sleep for.                            */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_setReasonForSleep(void* taskSleepResource, U1 resourceType, U4 period)
+{
+  OS_CPU_CRITICAL_ALLOC();
+  
+  /* Don't let scheduler interrupt itself. Ticker keeps ticking. */
+  OS_CPU_ENTER_CRITICAL();
+  
+  tcb_g_p_currentTaskBlock->resource = taskSleepResource;
+  tcb_g_p_currentTaskBlock->flags   |= (U1)resourceType;
+  
+#if(RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE)
+  vd_OStrace_record((U1)TRACE_EVT_TASK_SLEEP, tcb_g_p_currentTaskBlock->taskID, resourceType);
+#endif
+	
+	tcb_g_p_currentTaskBlock->sleepCntr = period; 
+  tcb_g_p_currentTaskBlock->flags    |= (U1)SCH_TASK_FLAG_STS_SLEEP;
+  
+  /* Switch to an active task */
+  vd_OSsch_setNextReadyTaskToRun();
+  OS_CPU_TRIGGER_DISPATCHER();
+  
+  /* Resume tick interrupts and enable context switch interrupt. */
+  OS_CPU_EXIT_CRITICAL();
+}
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_setNewPriority                               */
+/*  Purpose:       Function to change task priority in support of        */
+/*                 priority inheritance. Internal use only. Internal     */
+/*                 module must ensure that no two active tasks share     */
+/*                 the same priority value at any time.                  */
+/*  Arguments:     Sch_Task* tcb:                                        */
+/*                           Pointer to TCB to have priority changed.    */
+/*                 U1 newPriority:                                       */
+/*                                                                       */
+/*  Return:        U1: Previous priority value.                          */
+/*************************************************************************/
+U1 u1_OSsch_setNewPriority(struct Sch_Task* tcb, U1 newPriority)
+{
+  U1 u1_t_prevPrio;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  u1_t_prevPrio = tcb->priority;
+  
+#if(RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE)
+  vd_OStrace_record((U1)TRACE_EVT_PRIO_INHERIT, tcb->taskID, (U2)(((U2)u1_t_prevPrio << 8) | newPriority));
+#endif
+  
+  vd_sch_priorityChange(tcb, newPriority, (U1)SCH_PRIO_TRACE_INHERITANCE);
+  
+  OS_CPU_EXIT_CRITICAL();
+  
+  return (u1_t_prevPrio);
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_setInheritedDeadline                         */
+/*  Purpose:       Set absolute deadline that mutex holder inherits and  */
+/*                 re-sort ready queue. Internal use only.               */
+/*  Arguments:     Sch_Task* tcb:                                        */
+/*                           Pointer to TCB of mutex holder.             */
+/*                 U1 inherit:                                           */
+/*                           ONE to inherit deadline, ZERO to return to  */
+/*                           own deadline.                               */
+/*                 U4 deadline:                                          */
+/*                           Absolute deadline to inherit.               */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+void vd_OSsch_setInheritedDeadline(struct Sch_Task* tcb, U1 inherit, U4 deadline)
+{
+  OS_CPU_CRITICAL_ALLOC();
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  /* Holder that is sleeping or suspended is placed by inherited deadline when woken. */
+  if((tcb->flags & (U1)SCH_TASK_FLAG_STS_CHECK) == (U1)ZERO)
+  {
+    vd_sch_readyQueueRemove(Node_s_ap_mapTaskIDToTCB[tcb->taskID]);
+    
+    tcb->deadlineInherited = inherit;
+    tcb->inheritedDeadline = deadline;
+    
+    vd_sch_readyQueueInsert(Node_s_ap_mapTaskIDToTCB[tcb->taskID]);
+    
+    if(tcb_sch_readyQueueHighest() != tcb_g_p_currentTaskBlock)
+    {
+      tcb_g_p_nextTaskBlock = tcb_sch_readyQueueHighest();
+      
+      vd_sch_requestDispatch();
+    }
+    else{}
+  }
+  else
+  {
+    tcb->deadlineInherited = inherit;
+    tcb->inheritedDeadline = deadline;
+  }
+  
+  OS_CPU_EXIT_CRITICAL();
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_setTaskPriority                              */
+/*  Purpose:       Change priority of task. May be called from ISR.      */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*                 U1 newPriority:                                       */
+/*                    New priority level.                                */
+/*  Return:        SCH_SET_PRIORITY_SUCCESS   OR                         */
+/*                 SCH_SET_PRIORITY_DENIED                               */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_DYNAMIC_PRIORITY == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_setTaskPriority(U1 taskID, U1 newPriority)
+{
+  U1        u1_t_returnSts;
+  U1        u1_t_inherited;
+  U1        u1_t_prioInUse;
+  Sch_Task* tcb_t_p_task;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u1_t_returnSts = (U1)SCH_SET_PRIORITY_DENIED;
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  if((taskID < (U1)SCH_BG_TASK_ID) && (Node_s_ap_mapTaskIDToTCB[taskID] != (ListNode*)NULL) && !SCH_APP_PRIORITY_INVALID(newPriority))
+  {
+    tcb_t_p_task = Node_s_ap_mapTaskIDToTCB[taskID]->TCB;
+    
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+    /* While raised to threshold, any other priority was set by priority inheritance. */
+    if(tcb_t_p_task->basePriority != (U1)SCH_TASK_PRIORITY_UNDEFINED)
+    {
+      u1_t_inherited = (U1)((tcb_t_p_task->priority != tcb_t_p_task->preemptThreshold) || 
+                            (tcb_t_p_task->basePriority != tcb_t_p_task->assignedPriority));
+    }
+    else
+#endif
+    {
+      /* Priority differs from assigned priority only while inherited. */
+      u1_t_inherited = (U1)(tcb_t_p_task->priority != tcb_t_p_task->assignedPriority);
+    }
+    
+#if(RTOS_CONFIG_ENABLE_ROUND_ROBIN == RTOS_CONFIG_TRUE)
+    u1_t_prioInUse = (U1)SCH_FALSE;
+#else
+    /* Without round-robin no two tasks may share a priority. Kernel tasks are included. */
+    u1_t_prioInUse = u1_sch_priorityInUse(newPriority, tcb_t_p_task);
+#endif
+    
+    if((u1_t_inherited == (U1)SCH_FALSE) && (u1_t_prioInUse == (U1)SCH_FALSE))
+    {
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+      /* Threshold follows priority for normal preemption, and is never below priority. */
+      if((tcb_t_p_task->preemptThreshold == tcb_t_p_task->assignedPriority) || (newPriority < tcb_t_p_task->preemptThreshold))
+      {
+        tcb_t_p_task->preemptThreshold = newPriority;
+      }
+      else{}
+      
+      /* Running task stays at its threshold. New priority applies once it leaves run state. */
+      if(tcb_t_p_task->basePriority != (U1)SCH_TASK_PRIORITY_UNDEFINED)
+      {
+        tcb_t_p_task->basePriority = newPriority;
+        
+        if(tcb_t_p_task->priority != tcb_t_p_task->preemptThreshold)
+        {
+          vd_sch_priorityChange(tcb_t_p_task, tcb_t_p_task->preemptThreshold, (U1)SCH_PRIO_TRACE_APPLICATION);
+        }
+        else{}
+      }
+      else
+#endif
+      {
+        vd_sch_priorityChange(tcb_t_p_task, newPriority, (U1)SCH_PRIO_TRACE_APPLICATION);
+      }
+      
+      tcb_t_p_task->assignedPriority = newPriority;
+      u1_t_returnSts                 = (U1)SCH_SET_PRIORITY_SUCCESS;
+      
+#if(RTOS_CFG_OS_MUTEX_ENABLED == RTOS_CONFIG_TRUE)
+      /* Re-sort blocked list of mutex and update inheritance of its holder. */
+      if((tcb_t_p_task->flags & (U1)SCH_TASK_FLAG_STS_SLEEP) &&
+         ((tcb_t_p_task->flags & (U1)SCH_TASK_RESOURCE_SLEEP_CHECK_MASK) == (U1)SCH_TASK_FLAG_SLEEP_MUTEX))
+      {
+        vd_OSmutex_blockedPriorityChange((Mutex*)tcb_t_p_task->resource, tcb_t_p_task);
+      }
+      else{}
+#endif
+    }
+    else{}
+  }
+  else{}
+  
+  OS_CPU_EXIT_CRITICAL();
+  
+  return (u1_t_returnSts);
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_priorityTraceRead                            */
+/*  Purpose:       Copy recorded priority changes, oldest first, and     */
+/*                 remove them from trace buffer.                        */
+/*  Arguments:     OSPriorityTraceEntry* entries:                        */
+/*                    Array to copy entries to.                          */
+/*                 U1 maxEntries:                                        */
+/*                    Size of array.                                     */
+/*  Return:        U1: Number of entries copied.                         */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PRIORITY_TRACE == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_priorityTraceRead(OSPriorityTraceEntry* entries, U1 maxEntries)
+{
+  U1 u1_t_numRead;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u1_t_numRead = (U1)ZERO;
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  while((u1_t_numRead < maxEntries) && (u1_s_prioTraceCount != (U1)ZERO))
+  {
+    entries[u1_t_numRead] = PrioTrace_s_as_buffer[u1_s_prioTraceHead];
+    
+    if(++u1_s_prioTraceHead >= (U1)SCH_PRIO_TRACE_SIZE)
+    {
+      u1_s_prioTraceHead = (U1)ZERO;
+    }
+    else{}
+    
+    --u1_s_prioTraceCount;
+    ++u1_t_numRead;
+  }
+  
+  OS_CPU_EXIT_CRITICAL();
+  
+  return (u1_t_numRead);
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_setTaskDeadline                              */
+/*  Purpose:       Set EDF timing parameters of task and start a new job */
+/*                 of task now. Absolute deadline is computed again each */
+/*                 time task wakes after it finished its job by sleeping */
+/*                 or suspending itself. Resource and notify wakes keep  */
+/*                 the deadline of the current job.                      */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*                 U4 relativeDeadline:                                  */
+/*                    Deadline in ticks after each release. If zero,     */
+/*                    deadline is equal to period.                       */
+/*                 U4 period:                                            */
+/*                    Minimum time between releases in ticks. Task woken */
+/*                    earlier is given deadline of its earliest allowed  */
+/*                    release. Zero if aperiodic.                        */
+/*  Return:        SCH_SET_DEADLINE_SUCCESS   OR                         */
+/*                 SCH_SET_DEADLINE_DENIED                               */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_setTaskDeadline(U1 taskID, U4 relativeDeadline, U4 period)
+{
+  U1        u1_t_returnSts;
+  Sch_Task* tcb_t_p_task;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  if((taskID >= (U1)SCH_BG_TASK_ID) || (Node_s_ap_mapTaskIDToTCB[taskID] == (ListNode*)NULL))
+  {
+    u1_t_returnSts = (U1)SCH_SET_DEADLINE_DENIED;
+  }
+  /* Only constrained deadlines (deadline <= period) are supported. */
+  else if((period != (U4)ZERO) && (relativeDeadline > period))
+  {
+    u1_t_returnSts = (U1)SCH_SET_DEADLINE_DENIED;
+  }
+  else
+  {
+    OS_CPU_ENTER_CRITICAL();
+    
+    tcb_t_p_task         = Node_s_ap_mapTaskIDToTCB[taskID]->TCB;
+    tcb_t_p_task->period = period;
+    
+    /* Implicit deadline if none given. */
+    tcb_t_p_task->relDeadline = (relativeDeadline == (U4)ZERO) ? period : relativeDeadline;
+    
+    /* Task is treated as released now. Minimum inter-arrival time does not apply to this release. */
+    tcb_t_p_task->releaseTick = u4_s_tickCntr;
+    tcb_t_p_task->absDeadline = u4_s_tickCntr + tcb_t_p_task->relDeadline;
+    
+    /* If task is suspended or sleeping then it is placed by new deadline when woken. */
+    if((tcb_t_p_task->flags & (U1)SCH_TASK_FLAG_STS_CHECK) == (U1)ZERO)
+    {
+      /* Re-sort ready queue. */
+      vd_sch_readyQueueRemove(Node_s_ap_mapTaskIDToTCB[taskID]);
+      vd_sch_readyQueueInsert(Node_s_ap_mapTaskIDToTCB[taskID]);
+      
+      /* Has a different task become the earliest deadline ? */
+      if(tcb_sch_readyQueueHighest() != tcb_g_p_currentTaskBlock)
+      { 
+        /* Set global task pointer to new task control block */
+        tcb_g_p_nextTaskBlock = tcb_sch_readyQueueHighest();
+        
+        vd_sch_requestDispatch();
+      }
+      else
+      {
+        
+      }
+    }
+    else{}
+    
+    OS_CPU_EXIT_CRITICAL();
+    
+    u1_t_returnSts = (U1)SCH_SET_DEADLINE_SUCCESS;
+  }
+  
+  return (u1_t_returnSts);
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_partitionCreate                              */
+/*  Purpose:       Create partition with a CPU budget per major frame.   */
+/*  Arguments:     U1 partitionID:                                       */
+/*                    0 to RTOS_CONFIG_NUM_PARTITIONS - 1.               */
+/*                 const char* name:                                     */
+/*                    Name for debug. May be NULL.                       */
+/*                 U4 budget:                                            */
+/*                    Ticks per major frame.                             */
+/*  Return:        SCH_PARTITION_SUCCESS   OR                            */
+/*                 SCH_PARTITION_DENIED                                  */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_partitionCreate(U1 partitionID, const char* name, U4 budget)
+{
+  U1 u1_t_returnSts;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  if((partitionID >= (U1)SCH_NUM_PARTITIONS) || (budget == (U4)ZERO) || (budget > (U4)SCH_PARTITION_MAJOR_FRAME))
+  {
+    u1_t_returnSts = (U1)SCH_PARTITION_DENIED;
+  }
+  else
+  {
+    OS_CPU_ENTER_CRITICAL();
+    
+    Part_s_as_partitions[partitionID].name      = name;
+    Part_s_as_partitions[partitionID].budget    = budget;
+    Part_s_as_partitions[partitionID].remaining = budget;
+    
+    OS_CPU_EXIT_CRITICAL();
+    
+    u1_t_returnSts = (U1)SCH_PARTITION_SUCCESS;
+  }
+  
+  return (u1_t_returnSts);
+}
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_partitionAddTask                             */
+/*  Purpose:       Move task into a partition.                           */
+/*  Arguments:     U1 partitionID:                                       */
+/*                    ID of created partition.                           */
+/*                 U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*  Return:        SCH_PARTITION_SUCCESS   OR                            */
+/*                 SCH_PARTITION_DENIED                                  */
+/*************************************************************************/
+U1 u1_OSsch_partitionAddTask(U1 partitionID, U1 taskID)
+{
+  U1        u1_t_returnSts;
+  ListNode* node_t_p_task;
+  Sch_Task* tcb_t_p_task;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u1_t_returnSts = (U1)SCH_PARTITION_DENIED;
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  /* OS tasks cannot be partitioned. */
+  if((partitionID < (U1)SCH_NUM_PARTITIONS) && (Part_s_as_partitions[partitionID].budget != (U4)ZERO) &&
+     (taskID < (U1)SCH_BG_TASK_ID) && (Node_s_ap_mapTaskIDToTCB[taskID] != (ListNode*)NULL))
+  {
+    node_t_p_task = Node_s_ap_mapTaskIDToTCB[taskID];
+    tcb_t_p_task  = node_t_p_task->TCB;
+    
+    vd_sch_partitionRemoveMember(tcb_t_p_task);
+    
+    tcb_t_p_task->partition                  = partitionID;
+    tcb_t_p_task->partitionNext              = Part_s_as_partitions[partitionID].members;
+    Part_s_as_partitions[partitionID].members = tcb_t_p_task;
+    
+    /* Throttle state follows new partition. */
+    if(tcb_t_p_task->throttled)
+    {
+      tcb_t_p_task->throttled  = (U1)SCH_FALSE;
+      tcb_t_p_task->flags     &= ~((U1)SCH_TASK_FLAG_STS_SUSPENDED);
+      vd_list_removeNode(&node_s_p_headOfSuspendList, node_t_p_task);
+      
+      if(u1_sch_partitionPark(node_t_p_task) == (U1)SCH_FALSE)
+      {
+        vd_sch_readyQueueInsert(node_t_p_task);
+      }
+      else{}
+    }
+    else if((tcb_t_p_task->flags & (U1)SCH_TASK_FLAG_STS_CHECK) == (U1)ZERO)
+    {
+      vd_sch_readyQueueRemove(node_t_p_task);
+      
+      if(u1_sch_partitionPark(node_t_p_task) == (U1)SCH_FALSE)
+      {
+        vd_sch_readyQueueInsert(node_t_p_task);
+      }
+      else
+      {
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+        vd_sch_thresholdLower(tcb_t_p_task);
+#endif
+      }
+    }
+    else{}
+    
+    if(tcb_sch_readyQueueHighest() != tcb_g_p_currentTaskBlock)
+    {
+      tcb_g_p_nextTaskBlock = tcb_sch_readyQueueHighest();
+      
+      vd_sch_requestDispatch();
+    }
+    else{}
+    
+    u1_t_returnSts = (U1)SCH_PARTITION_SUCCESS;
+  }
+  else{}
+  
+  OS_CPU_EXIT_CRITICAL();
+  
+  return (u1_t_returnSts);
+}
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_partitionGetInfo                             */
+/*  Purpose:       Get budget state of a partition.                      */
+/*  Arguments:     U1 partitionID:                                       */
+/*                    ID of created partition.                           */
+/*                 OSPartitionInfo* info:                                */
+/*                    Partition state is copied here.                    */
+/*  Return:        SCH_PARTITION_SUCCESS   OR                            */
+/*                 SCH_PARTITION_DENIED                                  */
+/*************************************************************************/
+U1 u1_OSsch_partitionGetInfo(U1 partitionID, OSPartitionInfo* info)
+{
+  U1 u1_t_returnSts;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u1_t_returnSts = (U1)SCH_PARTITION_DENIED;
+  
+  if((partitionID < (U1)SCH_NUM_PARTITIONS) && (info != (OSPartitionInfo*)NULL))
+  {
+    OS_CPU_ENTER_CRITICAL();
+    
+    if(Part_s_as_partitions[partitionID].budget != (U4)ZERO)
+    {
+      info->name         = Part_s_as_partitions[partitionID].name;
+      info->budget       = Part_s_as_partitions[partitionID].budget;
+      info->remaining    = Part_s_as_partitions[partitionID].remaining;
+      info->exhaustCount = Part_s_as_partitions[partitionID].exhaustCount;
+      u1_t_returnSts     = (U1)SCH_PARTITION_SUCCESS;
+    }
+    else{}
+    
+    OS_CPU_EXIT_CRITICAL();
+  }
+  else{}
+  
+  return (u1_t_returnSts);
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_taskSleep                                    */
+/*  Purpose:       Suspend current task for a specified amount of time.  */
+/*  Arguments:     U4 u4_period:                                         */
+/*                    Time units to suspend for.                         */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_taskSleep(U4 period)
+{
+  OS_CPU_CRITICAL_ALLOC();
+  
+  /* Don't let scheduler interrupt itself. Ticker keeps ticking. */
+  OS_CPU_ENTER_CRITICAL();
+  
+#if(RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE)
+  vd_OStrace_record((U1)TRACE_EVT_TASK_SLEEP, tcb_g_p_currentTaskBlock->taskID, (U2)ZERO);
+#endif
+  
+  tcb_g_p_currentTaskBlock->sleepCntr = period; 
+  tcb_g_p_currentTaskBlock->flags    |= (U1)SCH_TASK_FLAG_STS_SLEEP;
+  
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+  /* Wake after sleep is a release. */
+  tcb_g_p_currentTaskBlock->jobDone   = (U1)SCH_TRUE;
+#endif
+  
+  /* Switch to an active task */
+  vd_OSsch_setNextReadyTaskToRun();
+  OS_CPU_TRIGGER_DISPATCHER();
+
+  /* Resume tick interrupts and enable context switch interrupt. */
+  OS_CPU_EXIT_CRITICAL();
+}
+
+/*************************************************************************/
+/*  Function Name: u4_OSsch_taskSleepSetFreq                             */
+/*  Purpose:       Used to set task to sleep such that task will run at a*/
+/*                 set frequency.                                        */
+/*  Arguments:     U4 nextWakeTime:                                      */
+/*                    Time to wake up at (in ticks). If this time has    */
+/*                    already passed, task does not sleep.               */
+/*  Return:        U4 u4_t_wakeTime:                                     */
+/*                    Tick value that task was most recently woken at.   */
+/*************************************************************************/
+U4 u4_OSsch_taskSleepSetFreq(U4 nextWakeTime)
+{
+  OS_CPU_CRITICAL_ALLOC();
+  
+  /* Don't let scheduler interrupt itself. Ticker keeps ticking. */
+  OS_CPU_ENTER_CRITICAL();
+
+  /* Wrap-safe compare. A task that has overrun its wake time runs again immediately. */
+  if(u1_OSsch_tickIsAfter(nextWakeTime, u4_s_tickCntr))
+  {
+#if(RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE)
+    vd_OStrace_record((U1)TRACE_EVT_TASK_SLEEP, tcb_g_p_currentTaskBlock->taskID, (U2)ZERO);
+#endif
+    
+    tcb_g_p_currentTaskBlock->sleepCntr = nextWakeTime - u4_s_tickCntr; 
+    tcb_g_p_currentTaskBlock->flags    |= (U1)SCH_TASK_FLAG_STS_SLEEP;
+    
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+    /* Wake after sleep is a release. */
+    tcb_g_p_currentTaskBlock->jobDone   = (U1)SCH_TRUE;
+#endif
+    
+    /* Switch to an active task */
+    vd_OSsch_setNextReadyTaskToRun();
+    OS_CPU_TRIGGER_DISPATCHER();
+  }
+  else
+  {
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+    /* Next job starts at once. */
+    vd_sch_edfNewJob(Node_s_ap_mapTaskIDToTCB[tcb_g_p_currentTaskBlock->taskID]);
+#endif
+  }
+  
+  /* Resume tick interrupts and enable context switch interrupt. */
+  OS_CPU_EXIT_CRITICAL();
+
+  return(u4_s_tickCntr);  
+}
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_taskWaitNextPeriod                           */
+/*  Purpose:       Complete current job of periodic task and block until */
+/*                 next release. Response time of completed job and      */
+/*                 release jitter of next job are recorded.              */
+/*  Arguments:     N/A                                                   */
+/*  Return:        SCH_PERIODIC_ON_TIME        OR                        */
+/*                 SCH_PERIODIC_OVERRUN        OR                        */
+/*                 SCH_PERIODIC_NOT_PERIODIC                             */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PERIODIC_TASKS == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_taskWaitNextPeriod(void)
+{
+  U1            u1_t_returnSts;
+  U4            u4_t_ticks;
+  Sch_Periodic* per_t_p_periodic;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  per_t_p_periodic = &(tcb_g_p_currentTaskBlock->periodic);
+  
+  if(per_t_p_periodic->period == (U4)ZERO)
+  {
+    u1_t_returnSts = (U1)SCH_PERIODIC_NOT_PERIODIC;
+  }
+  else
+  {
+    u1_t_returnSts = (U1)SCH_PERIODIC_ON_TIME;
+    
+    /* Account for job that is completing. */
+    if(per_t_p_periodic->jobActive)
+    {
+      u4_t_ticks = u4_s_tickCntr - per_t_p_periodic->releaseTick;
+      
+      ++(per_t_p_periodic->completions);
+      per_t_p_periodic->responseTotal += (U8)u4_t_ticks;
+      
+      if(u4_t_ticks > per_t_p_periodic->maxResponse)
+      {
+        per_t_p_periodic->maxResponse = u4_t_ticks;
+      }
+      else{}
+      
+      /* Deadline is inclusive. Job completing in the deadline tick is on time. */
+      if(u4_t_ticks > per_t_p_periodic->relDeadline)
+      {
+        ++(per_t_p_periodic->deadlineMisses);
+      }
+      else{}
+      
+      /* Next release is relative to previous release, not to completion, so releases do not drift. */
+      per_t_p_periodic->nextRelease = per_t_p_periodic->releaseTick + per_t_p_periodic->period;
+      per_t_p_periodic->jobActive   = (U1)SCH_FALSE;
+      
+      if(!u1_OSsch_tickIsAfter(per_t_p_periodic->nextRelease, u4_s_tickCntr))
+      {
+        ++(per_t_p_periodic->overruns);
+        u1_t_returnSts = (U1)SCH_PERIODIC_OVERRUN;
+      }
+      else{}
+    }
+    else{}
+    
+    /* Loop in case task is woken early by vd_OSsch_taskWake(). */
+    while(u1_OSsch_tickIsAfter(per_t_p_periodic->nextRelease, u4_s_tickCntr))
+    {
+      vd_OSsch_taskSleep(per_t_p_periodic->nextRelease - u4_s_tickCntr);
+      
+      /* Task switch happens here. */
+      OS_CPU_EXIT_CRITICAL();
+      OS_CPU_ENTER_CRITICAL();
+    }
+    
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+    /* Overrun job did not sleep, so next job is released here. */
+    if(u1_t_returnSts == (U1)SCH_PERIODIC_OVERRUN)
+    {
+      vd_sch_edfNewJob(Node_s_ap_mapTaskIDToTCB[tcb_g_p_currentTaskBlock->taskID]);
+    }
+    else{}
+#endif
+    
+    /* Start next job. */
+    per_t_p_periodic->releaseTick = per_t_p_periodic->nextRelease;
+    per_t_p_periodic->jobActive   = (U1)SCH_TRUE;
+    ++(per_t_p_periodic->releases);
+    
+    u4_t_ticks = u4_s_tickCntr - per_t_p_periodic->releaseTick;
+    
+    if(u4_t_ticks > per_t_p_periodic->maxJitter)
+    {
+      per_t_p_periodic->maxJitter = u4_t_ticks;
+    }
+    else{}
+  }
+  
+  OS_CPU_EXIT_CRITICAL();
+  
+  return (u1_t_returnSts);
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_getPeriodicStats                             */
+/*  Purpose:       Get timing statistics of a periodic task.             */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*                 OSPeriodicStats* stats:                               */
+/*                    Statistics are copied here.                        */
+/*  Return:        SCH_PERIODIC_STATS_SUCCESS   OR                       */
+/*                 SCH_PERIODIC_STATS_DENIED                             */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PERIODIC_TASKS == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_getPeriodicStats(U1 taskID, OSPeriodicStats* stats)
+{
+  U1            u1_t_returnSts;
+  U4            u4_t_completions;
+  U8            u8_t_responseTotal;
+  Sch_Periodic* per_t_p_periodic;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u1_t_returnSts = (U1)SCH_PERIODIC_STATS_DENIED;
+  
+  if((stats != (OSPeriodicStats*)NULL) && (taskID < (U1)SCH_BG_TASK_ID) && (Node_s_ap_mapTaskIDToTCB[taskID] != (ListNode*)NULL))
+  {
+    OS_CPU_ENTER_CRITICAL();
+    
+    per_t_p_periodic = &(Node_s_ap_mapTaskIDToTCB[taskID]->TCB->periodic);
+    
+    if(per_t_p_periodic->period != (U4)ZERO)
+    {
+      stats->releases       = per_t_p_periodic->releases;
+      stats->maxJitter      = per_t_p_periodic->maxJitter;
+      stats->maxResponse    = per_t_p_periodic->maxResponse;
+      stats->overruns       = per_t_p_periodic->overruns;
+      stats->deadlineMisses = per_t_p_periodic->deadlineMisses;
+      u4_t_completions      = per_t_p_periodic->completions;
+      u8_t_responseTotal    = per_t_p_periodic->responseTotal;
+      u1_t_returnSts        = (U1)SCH_PERIODIC_STATS_SUCCESS;
+    }
+    else{}
+    
+    OS_CPU_EXIT_CRITICAL();
+    
+    /* Divide outside of critical section. */
+    if(u1_t_returnSts == (U1)SCH_PERIODIC_STATS_SUCCESS)
+    {
+      stats->avgResponse = (u4_t_completions != (U4)ZERO) ? (U4)(u8_t_responseTotal/(U8)u4_t_completions) : (U4)ZERO;
+    }
+    else{}
+  }
+  else{}
+  
+  return (u1_t_returnSts);
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_resetPeriodicStats                           */
+/*  Purpose:       Clear timing statistics of a periodic task.           */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task.                                        */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PERIODIC_TASKS == RTOS_CONFIG_TRUE)
+void vd_OSsch_resetPeriodicStats(U1 taskID)
+{
+  OS_CPU_CRITICAL_ALLOC();
+  
+  if((taskID < (U1)SCH_BG_TASK_ID) && (Node_s_ap_mapTaskIDToTCB[taskID] != (ListNode*)NULL))
+  {
+    OS_CPU_ENTER_CRITICAL();
+    
+    vd_sch_periodicStatsClear(&(Node_s_ap_mapTaskIDToTCB[taskID]->TCB->periodic));
+    
+    OS_CPU_EXIT_CRITICAL();
+  }
+  else{}
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_taskYield                                    */
+/*  Purpose:       Move current task to the tail of its priority level   */
+/*                 and run the next ready task at that level, if any.    */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_ROUND_ROBIN == RTOS_CONFIG_TRUE)
+void vd_OSsch_taskYield(void)
+{
+  ListNode* node_t_p_current;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  node_t_p_current = Node_s_ap_mapTaskIDToTCB[tcb_g_p_currentTaskBlock->taskID];
+  
+  /* Ready lists are FIFO, so re-inserting rotates task to tail of its level. */
+  vd_sch_readyQueueRemove(node_t_p_current);
+  vd_sch_readyQueueInsert(node_t_p_current);
+  
+  /* Next task gets a full time slice. */
+  u4_s_sliceCntr     = (U4)SCH_TIME_SLICE_TICKS;
+  tcb_s_p_sliceOwner = tcb_sch_readyQueueHighest();
+  
+  if(tcb_s_p_sliceOwner != tcb_g_p_currentTaskBlock)
+  {
+    tcb_g_p_nextTaskBlock = tcb_s_p_sliceOwner;
+    vd_sch_requestDispatch();
+  }
+  else{}
+  
+  OS_CPU_EXIT_CRITICAL();
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_taskWake                                     */
+/*  Purpose:       Wake specified task from sleep or suspended state.    */
+/*                 Kernel task IDs and deleted tasks are ignored.        */
+/*  Arguments:     U1 taskID:                                            */
+/*                    Task ID to be woken from sleep or suspend state.   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_taskWake(U1 taskID)
+{  
+  OS_CPU_CRITICAL_ALLOC();
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  if((taskID < (U1)SCH_BG_TASK_ID) && (Node_s_ap_mapTaskIDToTCB[taskID] != (ListNode*)NULL))
+  {
+    vd_sch_taskWake(Node_s_ap_mapTaskIDToTCB[taskID]);
+  }
+  else{}
+  
+  OS_CPU_EXIT_CRITICAL();
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_wakeBatchBegin                               */
+/*  Purpose:       Clear wake batch before tasks are added.              */
+/*  Arguments:     OSWakeBatch* batch:                                   */
+/*                    Batch owned by caller.                             */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_WAKE_BATCH == RTOS_CONFIG_TRUE)
+void vd_OSsch_wakeBatchBegin(OSWakeBatch* batch)
+{
+  U1 u1_t_index;
+  
+  for(u1_t_index = (U1)ZERO; u1_t_index < (U1)SCH_WAKE_BATCH_NUM_WORDS; u1_t_index++)
+  {
+    batch->taskMap[u1_t_index] = (U4)ZERO;
+  }
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_wakeBatchAdd                                 */
+/*  Purpose:       Add task to wake batch.                               */
+/*  Arguments:     OSWakeBatch* batch:                                   */
+/*                    Batch owned by caller.                             */
+/*                 U1 taskID:                                            */
+/*                    Task ID to be woken from sleep or suspend state.   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_wakeBatchAdd(OSWakeBatch* batch, U1 taskID)
+{
+  if(taskID < (U1)SCH_BG_TASK_ID)
+  {
+    batch->taskMap[taskID >> SCH_SLOT_MAP_SHIFT] |= ((U4)SCH_PRIO_MAP_MSB >> (taskID & (U1)SCH_SLOT_MAP_MASK));
+  }
+  else{}
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_wakeBatchCommit                              */
+/*  Purpose:       Wake all tasks in batch under one critical section,   */
+/*                 then check for preemption once.                       */
+/*  Arguments:     OSWakeBatch* batch:                                   */
+/*                    Batch owned by caller.                             */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_wakeBatchCommit(OSWakeBatch* batch)
+{
+  U1        u1_t_word;
+  U1        u1_t_taskID;
+  U1        u1_t_released;
+  ListNode* node_t_p_task;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u1_t_released = (U1)SCH_FALSE;
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  for(u1_t_word = (U1)ZERO; u1_t_word < (U1)SCH_WAKE_BATCH_NUM_WORDS; u1_t_word++)
+  {
+    /* Only set bits are visited. */
+    while(batch->taskMap[u1_t_word] != (U4)ZERO)
+    {
+      u1_t_taskID = (U1)(u1_t_word << SCH_SLOT_MAP_SHIFT) + OS_CPU_COUNT_LEADING_ZEROS(batch->taskMap[u1_t_word]);
+      
+      batch->taskMap[u1_t_word] &= ~((U4)SCH_PRIO_MAP_MSB >> (u1_t_taskID & (U1)SCH_SLOT_MAP_MASK));
+      
+      node_t_p_task = Node_s_ap_mapTaskIDToTCB[u1_t_taskID];
+      
+      /* Skip deleted tasks and tasks already in ready state. */
+      if((node_t_p_task != (ListNode*)NULL) && (node_t_p_task->TCB->flags & (U1)SCH_TASK_FLAG_STS_CHECK))
+      {
+#if(RTOS_CONFIG_CALC_TASK_CPU_LOAD == RTOS_CONFIG_TRUE)
+        /* Check if CPU was previously idle, make calculation if so. Only done for first woken task. */
+        if((u1_t_released == (U1)SCH_FALSE) && (tcb_g_p_currentTaskBlock == (Node_s_ap_mapTaskIDToTCB[SCH_BG_TASK_ID]->TCB)))
+        {
+          OS_s_cpuData.CPUIdlePercent.CPU_idleRunning += (u1_cpu_getPercentOfTick() - OS_s_cpuData.CPUIdlePercent.CPU_idlePrevTimestamp);
+        }
+        else {}
+#endif
+        
+        vd_sch_taskRelease(node_t_p_task);
+        u1_t_released = (U1)SCH_TRUE;
+      }
+      else{}
+    }
+  }
+  
+  /* One preemption check for whole batch. */
+  if(tcb_sch_readyQueueHighest() != tcb_g_p_currentTaskBlock)
+  {
+    tcb_g_p_nextTaskBlock = tcb_sch_readyQueueHighest();
+    
+    vd_sch_requestDispatch();
+  }
+  else{}
+  
+  OS_CPU_EXIT_CRITICAL();
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_taskSuspend                                  */
+/*  Purpose:       Suspend current task for a specified amount of time.  */
+/*                 Kernel task IDs and deleted tasks are ignored.        */
+/*  Arguments:     U1 taskIndex:                                         */
+/*                    Task ID to be suspended.                           */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_taskSuspend(U1 taskIndex)
+{
+  OS_CPU_CRITICAL_ALLOC();
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  if((taskIndex < (U1)SCH_BG_TASK_ID) && (Node_s_ap_mapTaskIDToTCB[taskIndex] != (ListNode*)NULL))
+  {
+    vd_sch_taskSuspend(Node_s_ap_mapTaskIDToTCB[taskIndex]);
+  }
+  else{}
+  
+  /* Resume tick interrupts and enable context switch interrupt. */
+  OS_CPU_EXIT_CRITICAL();
+}
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_taskDelete                                   */
+/*  Purpose:       Delete task. Task is removed from all scheduler and   */
+/*                 resource lists, and its TCB slot and task ID can be   */
+/*                 used by u1_OSsch_createTask() again. Denied if task   */
+/*                 owns a mutex, or if task deletes itself while holding */
+/*                 scheduler lock. Task stack is not touched after       */
+/*                 return.                                               */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task to be deleted. May be current task.     */
+/*  Return:        SCH_TASK_DELETE_SUCCESS   OR                          */
+/*                 SCH_TASK_DELETE_DENIED                                */
+/*************************************************************************/
+U1 u1_OSsch_taskDelete(U1 taskID)
+{
+  U1        u1_t_returnSts;
+  ListNode* node_t_p_task;
+  Sch_Task* tcb_t_p_task;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u1_t_returnSts = (U1)SCH_TASK_DELETE_DENIED;
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  /* Background task cannot be deleted. */
+  if((taskID < (U1)SCH_BG_TASK_ID) && (Node_s_ap_mapTaskIDToTCB[taskID] != (ListNode*)NULL) &&
+     (u1_sch_taskHoldsResource(Node_s_ap_mapTaskIDToTCB[taskID]->TCB) == (U1)SCH_FALSE))
+  {
+    node_t_p_task = Node_s_ap_mapTaskIDToTCB[taskID];
+    tcb_t_p_task  = node_t_p_task->TCB;
+    
+    vd_sch_taskUnlink(node_t_p_task);
+    
+    /* Running task deleting itself. Its context must not be saved into a TCB that may be reused. */
+    if(tcb_t_p_task == tcb_g_p_currentTaskBlock)
+    {
+      vd_sch_discardCurrentContext();
+    }
+    else{}
+    
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+    vd_sch_partitionRemoveMember(tcb_t_p_task);
+#endif
+    
+    /* Release task ID and TCB slot */
+    Node_s_ap_mapTaskIDToTCB[taskID] = (ListNode*)NULL;
+    tcb_t_p_task->taskID             = (U1)SCH_INVALID_TASK_ID;
+    tcb_t_p_task->priority           = (U1)SCH_TASK_PRIORITY_UNDEFINED;
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+    tcb_t_p_task->relDeadline        = (U4)ZERO;
+    tcb_t_p_task->period             = (U4)ZERO;
+    tcb_t_p_task->jobDone            = (U1)SCH_FALSE;
+#endif
+#if(RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE)
+    tcb_t_p_task->runCycles          = (U8)ZERO;
+    tcb_t_p_task->maxBurstCycles     = (U4)ZERO;
+    tcb_t_p_task->windowCycles       = (U4)ZERO;
+    tcb_t_p_task->loadPercent        = (U1)ZERO;
+#endif
+    vd_sch_freeTaskSlot((U1)(tcb_t_p_task - SchTask_s_as_taskList));
+    --u1_s_numTasks;
+    
+    u1_t_returnSts = (U1)SCH_TASK_DELETE_SUCCESS;
+  }
+  else{}
+  
+  OS_CPU_EXIT_CRITICAL();
+  
+  return (u1_t_returnSts);
+}
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_taskRestart                                  */
+/*  Purpose:       Restart task from its entry point with a fresh stack. */
+/*                 Task is removed from all scheduler and resource lists */
+/*                 and made ready. Priority is not changed. Denied if    */
+/*                 task owns a mutex, or if task restarts itself while   */
+/*                 holding scheduler lock.                               */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task to be restarted. May be current task.   */
+/*  Return:        SCH_TASK_RESTART_SUCCESS   OR                         */
+/*                 SCH_TASK_RESTART_DENIED                               */
+/*************************************************************************/
+U1 u1_OSsch_taskRestart(U1 taskID)
+{
+  U1        u1_t_returnSts;
+  ListNode* node_t_p_task;
+  Sch_Task* tcb_t_p_task;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u1_t_returnSts = (U1)SCH_TASK_RESTART_DENIED;
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  /* Background task cannot be restarted. */
+  if((taskID < (U1)SCH_BG_TASK_ID) && (Node_s_ap_mapTaskIDToTCB[taskID] != (ListNode*)NULL) &&
+     (u1_sch_taskHoldsResource(Node_s_ap_mapTaskIDToTCB[taskID]->TCB) == (U1)SCH_FALSE))
+  {
+    node_t_p_task = Node_s_ap_mapTaskIDToTCB[taskID];
+    tcb_t_p_task  = node_t_p_task->TCB;
+    
+    vd_sch_taskUnlink(node_t_p_task);
+    
+    /* Running task restarting itself. Old context is discarded so new stack frame is used on dispatch. */
+    if(tcb_t_p_task == tcb_g_p_currentTaskBlock)
+    {
+      vd_sch_discardCurrentContext();
+    }
+    else{}
+    
+    /* Rebuild initial stack frame */
+#if(SCH_STACK_LIMIT_MARK == RTOS_CONFIG_TRUE)
+    *tcb_t_p_task->topOfStack = (OS_STACK)SCH_TOP_OF_STACK_MARK;
+#endif
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+    /* Shared stack may be in use by another task. Stack frame is built when task is dispatched. */
+    if(tcb_t_p_task->sharedStack)
+    {
+      tcb_t_p_task->stackPtr  = (OS_STACK*)NULL;
+    }
+    else
+#endif
+    {
+      tcb_t_p_task->stackPtr  = sp_cpu_taskStackInit(tcb_t_p_task->taskFcn, tcb_t_p_task->stackBase, &vd_sch_taskReturn);
+    }
+    tcb_t_p_task->wakeReason  = (U1)ZERO;
+    
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+    /* Restarted task begins a new job. */
+    tcb_t_p_task->jobDone     = (U1)SCH_TRUE;
+    vd_sch_edfRelease(tcb_t_p_task);
+#endif
+    
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+    if(u1_sch_partitionPark(node_t_p_task) == (U1)SCH_FALSE)
+#endif
+    {
+      vd_sch_readyQueueInsert(node_t_p_task);
+    }
+    
+    /* Is restarted task higher priority than current task ? */
+    if(tcb_sch_readyQueueHighest() != tcb_g_p_currentTaskBlock)
+    {
+      tcb_g_p_nextTaskBlock = tcb_sch_readyQueueHighest();
+      
+      vd_sch_requestDispatch();
+    }
+    else{}
+    
+    u1_t_returnSts = (U1)SCH_TASK_RESTART_SUCCESS;
+  }
+  else{}
+  
+  OS_CPU_EXIT_CRITICAL();
+  
+  return (u1_t_returnSts);
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_suspendScheduler                             */
+/*  Purpose:       Turn off scheduler interrupts and reset ticker.       */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_suspendScheduler(void)
+{
+  vd_cpu_suspendScheduler();
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_lockScheduler                                */
+/*  Purpose:       Prevent preemption of current task without masking    */
+/*                 interrupts. Supports nesting. Task must not block     */
+/*                 while scheduler is locked. If it does, other tasks    */
+/*                 are scheduled normally and a lock call from one of    */
+/*                 them calls OSTaskFault(). Not callable from ISR.      */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_lockScheduler(void)
+{
+  OS_CPU_CRITICAL_ALLOC();
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  if(u1_s_schLockNest == (U1)ZERO)
+  {
+    tcb_s_p_schLockOwner = tcb_g_p_currentTaskBlock;
+  }
+  else{}
+  
+  /* Lock held by another task is only possible if that task blocked while holding it. */
+  if(tcb_s_p_schLockOwner == tcb_g_p_currentTaskBlock)
+  {
+    ++u1_s_schLockNest;
+  }
+  else
+  {
+    OSTaskFault();
+  }
+  
+  OS_CPU_EXIT_CRITICAL();
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_unlockScheduler                              */
+/*  Purpose:       Release scheduler lock. Final unlock runs any         */
+/*                 reschedule that was deferred while lock was held.     */
+/*                 Ignored if current task does not hold lock.           */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OSsch_unlockScheduler(void)
+{
+  OS_CPU_CRITICAL_ALLOC();
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  /* Unlock by a task that does not hold lock is ignored. */
+  if((u1_s_schLockNest != (U1)ZERO) && (tcb_s_p_schLockOwner == tcb_g_p_currentTaskBlock))
+  {
+    --u1_s_schLockNest;
+    
+    if(u1_s_schLockNest == (U1)ZERO)
+    {
+      tcb_s_p_schLockOwner = (Sch_Task*)NULL;
+      
+      if(u1_s_dispatchPending == (U1)SCH_TRUE)
+      {
+        u1_s_dispatchPending = (U1)SCH_FALSE;
+        
+        if(tcb_sch_readyQueueHighest() != tcb_g_p_currentTaskBlock)
+        {
+          tcb_g_p_nextTaskBlock = tcb_sch_readyQueueHighest();
+          
+          OS_CPU_TRIGGER_DISPATCHER();
+        }
+        else{}
+      }
+      else{}
+    }
+    else{}
+  }
+  else{}
+  
+  OS_CPU_EXIT_CRITICAL();
+}
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_taskNotify                                   */
+/*  Purpose:       Send notification directly to task. Wakes task if it  */
+/*                 is waiting for a notification. Callable from ISR.     */
+/*  Arguments:     U1 taskID:                                            */
+/*                    ID of task to notify.                              */
+/*                 U4 value:                                             */
+/*                    Used by SCH_NOTIFY_SET_BITS and                    */
+/*                    SCH_NOTIFY_OVERWRITE, otherwise ignored.           */
+/*                 U1 action:                                            */
+/*                    Update made to notification value.                 */
+/*  Return:        SCH_NOTIFY_SUCCESS   OR                               */
+/*                 SCH_NOTIFY_DENIED                                     */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_TASK_NOTIFY == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_taskNotify(U1 taskID, U4 value, U1 action)
+{
+  U1        u1_t_returnSts;
+  U1        u1_t_prevState;
+  Sch_Task* tcb_t_p_task;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u1_t_returnSts = (U1)SCH_NOTIFY_DENIED;
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  if((taskID < (U1)SCH_BG_TASK_ID) && (Node_s_ap_mapTaskIDToTCB[taskID] != (ListNode*)NULL))
+  {
+    tcb_t_p_task   = Node_s_ap_mapTaskIDToTCB[taskID]->TCB;
+    u1_t_returnSts = (U1)SCH_NOTIFY_SUCCESS;
+    
+    switch(action)
+    {
+      case SCH_NOTIFY_GIVE:
+        break;
+      
+      case SCH_NOTIFY_SET_BITS:
+        tcb_t_p_task->notifyValue |= value;
+        break;
+      
+      case SCH_NOTIFY_INCREMENT:
+        ++(tcb_t_p_task->notifyValue);
+        break;
+      
+      case SCH_NOTIFY_OVERWRITE:
+        tcb_t_p_task->notifyValue = value;
+        break;
+      
+      default:
+        u1_t_returnSts = (U1)SCH_NOTIFY_DENIED;
+        break;
+    }
+    
+    if(u1_t_returnSts == (U1)SCH_NOTIFY_SUCCESS)
+    {
+      u1_t_prevState            = tcb_t_p_task->notifyState;
+      tcb_t_p_task->notifyState = (U1)SCH_NOTIFY_STATE_PENDING;
+      
+      /* Waiting task is not blocked on a resource, so it is woken directly. */
+      if(u1_t_prevState == (U1)SCH_NOTIFY_STATE_WAITING)
+      {
+        tcb_t_p_task->wakeReason = (U1)SCH_TASK_WAKEUP_NOTIFY;
+        vd_OSsch_taskWake(taskID);
+      }
+      else{}
+    }
+    else{}
+  }
+  else{}
+  
+  OS_CPU_EXIT_CRITICAL();
+  
+  return (u1_t_returnSts);
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_OSsch_taskNotifyWait                               */
+/*  Purpose:       Wait for notification to current task. Pending state  */
+/*                 is cleared on return.                                 */
+/*  Arguments:     U4 clearBitsOnExit:                                   */
+/*                    Bits cleared in notification value if notification */
+/*                    was received.                                      */
+/*                 U4* notifyValue:                                      */
+/*                    Notification value before bits are cleared. May be */
+/*                    NULL.                                              */
+/*                 U4 blockPeriod:                                       */
+/*                    Ticks to wait, or SCH_NOTIFY_NO_BLOCK or           */
+/*                    SCH_NOTIFY_WAIT_FOREVER.                           */
+/*  Return:        SCH_NOTIFY_RECEIVED   OR                              */
+/*                 SCH_NOTIFY_TIMEOUT                                    */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_TASK_NOTIFY == RTOS_CONFIG_TRUE)
+U1 u1_OSsch_taskNotifyWait(U4 clearBitsOnExit, U4* notifyValue, U4 blockPeriod)
+{
+  U1        u1_t_returnSts;
+  Sch_Task* tcb_t_p_task;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  tcb_t_p_task = tcb_g_p_currentTaskBlock;
+  
+  if((tcb_t_p_task->notifyState != (U1)SCH_NOTIFY_STATE_PENDING) && (blockPeriod != (U4)SCH_NOTIFY_NO_BLOCK))
+  {
+    tcb_t_p_task->notifyState = (U1)SCH_NOTIFY_STATE_WAITING;
+    
+    /* Dispatch is held off by outer critical section until exit below. */
+    if(blockPeriod == (U4)SCH_NOTIFY_WAIT_FOREVER)
+    {
+      vd_OSsch_taskSuspend(tcb_t_p_task->taskID);
+    }
+    else
+    {
+      vd_OSsch_taskSleep(blockPeriod);
+    }
+    
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+    /* Task is waiting within its job. Notification or timeout is not a release. */
+    tcb_t_p_task->jobDone = (U1)SCH_FALSE;
+#endif
+    
+    OS_CPU_EXIT_CRITICAL();
+    
+    /* Task resumes here after notification or timeout. */
+    OS_CPU_ENTER_CRITICAL();
+  }
+  else{}
+  
+  if(notifyValue != (U4*)NULL)
+  {
+    *notifyValue = tcb_t_p_task->notifyValue;
+  }
+  else{}
+  
+  if(tcb_t_p_task->notifyState == (U1)SCH_NOTIFY_STATE_PENDING)
+  {
+    tcb_t_p_task->notifyValue &= ~clearBitsOnExit;
+    u1_t_returnSts             = (U1)SCH_NOTIFY_RECEIVED;
+  }
+  else
+  {
+    u1_t_returnSts = (U1)SCH_NOTIFY_TIMEOUT;
+  }
+  
+  tcb_t_p_task->notifyState = (U1)SCH_NOTIFY_STATE_NOT_WAITING;
+  
+  OS_CPU_EXIT_CRITICAL();
+  
+  return (u1_t_returnSts);
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_systemTick_ISR                               */
+/*  Purpose:       Handle system tick operations and run scheduler.      */
+/*                 Entered from SysTick_Handler in taskSwitch.s when     */
+/*                 profiler is enabled.                                  */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+__irq void vd_OSsch_systemTick_ISR(void)
+{
+  U1 u1_t_prioMask;
+#if((RTOS_CONFIG_ENABLE_TICK_TASK == RTOS_CONFIG_TRUE) || (RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE) || (RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE))
+  OS_CPU_CRITICAL_ALLOC();
+#endif
+
+  u1_t_prioMask = u1_OSsch_interruptEnter();
+  
+  /* Increment 64-bit tick count. High word carries when low word wraps. */
+  if(++u4_s_tickCntr == (U4)ZERO)
+  {
+    ++u4_s_tickCntrHigh;
+  }
+  else{}
+  
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+  /* Charge interrupted task's partition before any task is woken on this tick. */
+  OS_CPU_ENTER_CRITICAL();
+  vd_sch_partitionTick();
+  OS_CPU_EXIT_CRITICAL();
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+  /* Table releases are made here, not by the tick task, so release time does not depend on other expiries. */
+  OS_CPU_ENTER_CRITICAL();
+  vd_sch_scheduleTableTick();
+  OS_CPU_EXIT_CRITICAL();
+#endif
+  
+#if(RTOS_CONFIG_CALC_TASK_CPU_LOAD == RTOS_CONFIG_TRUE)
+  /* Check if CPU was previously idle, make calculation if so. */
+  if(tcb_g_p_currentTaskBlock == (Node_s_ap_mapTaskIDToTCB[SCH_BG_TASK_ID]->TCB))
+  {
+    OS_s_cpuData.CPUIdlePercent.CPU_idleRunning += ((U1)SCH_ONE_HUNDRED_PERCENT - OS_s_cpuData.CPUIdlePercent.CPU_idlePrevTimestamp);
+  }
+  else{}
+  
+  if(--u1_s_cpuLoadWindowTicks == (U1)ZERO)
+  {
+    /* Average over 100 ticks. Running sum is at most 100 percent per tick. */
+    u1_s_cpuLoadWindowTicks                     = (U1)SCH_HUNDRED_TICKS;
+    OS_s_cpuData.CPUIdlePercent.CPU_idleAvg     = (U1)((OS_s_cpuData.CPUIdlePercent.CPU_idleRunning * (U4)SCH_DIV_HUNDRED_MULT) >> SCH_DIV_HUNDRED_SHIFT);
+    OS_s_cpuData.CPUIdlePercent.CPU_idleRunning = (U1)ZERO;
+  }
+  else{}
+  
+  OS_s_cpuData.CPUIdlePercent.CPU_idlePrevTimestamp = (U1)ZERO;
+#endif  
+  
+#if(RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE)
+  if(++u4_s_loadWindowTicks >= (U4)SCH_HUNDRED_TICKS)
+  {
+    vd_sch_runTimeLoadWindow();
+  }
+  else{}
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_TICK_TASK == RTOS_CONFIG_TRUE)
+  OS_CPU_ENTER_CRITICAL();
+  
+#if(RTOS_CONFIG_ENABLE_ROUND_ROBIN == RTOS_CONFIG_TRUE)
+  /* Quantum is charged here, where current task is the interrupted task and not the tick task. */
+  vd_sch_timeSlice();
+#endif
+  
+  /* Only head of delta list is counted here. Expiries are processed by tick task, woken only once head is due. */
+  if(node_s_p_headOfSleepList != (ListNode*)NULL)
+  {
+    if(node_s_p_headOfSleepList->TCB->sleepCntr != (U4)ZERO)
+    {
+      --(node_s_p_headOfSleepList->TCB->sleepCntr);
+    }
+    else
+    {
+      ++u4_s_overdueTicks;
+    }
+    
+    if(node_s_p_headOfSleepList->TCB->sleepCntr == (U4)ZERO)
+    {
+      vd_sch_taskWake(Node_s_ap_mapTaskIDToTCB[SCH_TICK_TASK_ID]);
+    }
+    else{}
+  }
+  else{}
+  
+  OS_CPU_EXIT_CRITICAL();
+#else
+  vd_OSsch_periodicScheduler();
+#endif
+
+  /* Resume tick interrupts and enable context switch interrupt. */
+  vd_OSsch_interruptExit(u1_t_prioMask);
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_memFault_ISR                                 */
+/*  Purpose:       MemManage fault. Raised when running task or an ISR   */
+/*                 nested on its stack writes into stack guard region.   */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_MPU_STACK_GUARD == RTOS_CONFIG_TRUE)
+__irq void vd_OSsch_memFault_ISR(void)
+{
+  vd_sch_stackGuardFault();
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_hardFault_ISR                                */
+/*  Purpose:       Hard fault. Stack overflow usually arrives here, as   */
+/*                 MemManage exception stacking also hits guard region   */
+/*                 and escalates. Hard fault handler runs with MPU off.  */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+__irq void vd_OSsch_hardFault_ISR(void)
+{
+  vd_sch_stackGuardFault();
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_sch_tickTask                                       */
+/*  Purpose:       Kernel task woken by SysTick when head of sleep list  */
+/*                 is due. Processes sleep expiry and resource timeouts, */
+/*                 one expiry per critical section, then suspends itself.*/
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_TICK_TASK == RTOS_CONFIG_TRUE)
+static void vd_sch_tickTask(void)
+{
+  OS_CPU_CRITICAL_ALLOC();
+  
+  for(;;)
+  {
+    OS_CPU_ENTER_CRITICAL();
+    
+    /* Head may have been woken early, leaving overdue ticks for new head. */
+    vd_sch_tickApplyOverdue();
+    
+    while((node_s_p_headOfSleepList != (ListNode*)NULL) && (node_s_p_headOfSleepList->TCB->sleepCntr == (U4)ZERO))
+    {
+      vd_sch_sleepExpireHead();
+      vd_sch_tickApplyOverdue();
+      
+      /* Let pending interrupts run between expiries. */
+      OS_CPU_EXIT_CRITICAL();
+      OS_CPU_ENTER_CRITICAL();
+    }
+    
+    /* Nothing due. SysTick wakes this task again when head of sleep list is due. */
+    vd_sch_taskSuspend(Node_s_ap_mapTaskIDToTCB[SCH_TICK_TASK_ID]);
+    
+    OS_CPU_EXIT_CRITICAL();
+  }
+}
+
+/*************************************************************************/
+/*  Function Name: vd_sch_tickApplyOverdue                               */
+/*  Purpose:       Charge ticks counted while head of sleep list was due */
+/*                 to current head. Call with interrupts disabled.       */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_tickApplyOverdue(void)
+{
+  if(node_s_p_headOfSleepList == (ListNode*)NULL)
+  {
+    u4_s_overdueTicks = (U4)ZERO;
+  }
+  else if(node_s_p_headOfSleepList->TCB->sleepCntr > u4_s_overdueTicks)
+  {
+    node_s_p_headOfSleepList->TCB->sleepCntr -= u4_s_overdueTicks;
+    u4_s_overdueTicks                         = (U4)ZERO;
+  }
+  else
+  {
+    u4_s_overdueTicks                        -= node_s_p_headOfSleepList->TCB->sleepCntr;
+    node_s_p_headOfSleepList->TCB->sleepCntr  = (U4)ZERO;
+  }
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_setNextReadyTaskToRun                        */
+/*  Purpose:       Select next task to run.                              */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_OSsch_setNextReadyTaskToRun(void)
+{
+  ListNode* node_t_p_moveToSleepList;
+
+  /* Remove node of task that was previously executing */
+  node_t_p_moveToSleepList = Node_s_ap_mapTaskIDToTCB[tcb_g_p_currentTaskBlock->taskID];
+  vd_sch_readyQueueRemove(node_t_p_moveToSleepList);
+  
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+  vd_sch_thresholdLower(tcb_g_p_currentTaskBlock);
+#endif
+  
+  /* A zero period would stall every task behind it in the delta list. Sleep at least one tick. */
+  if(tcb_g_p_currentTaskBlock->sleepCntr == (U4)ZERO)
+  {
+    tcb_g_p_currentTaskBlock->sleepCntr = (U4)SCH_MIN_SLEEP_TICKS;
+  }
+  else{}
+  
+  /* Move previous node to sleep list ordered by wake time */
+  vd_list_addNodeByDelta(&node_s_p_headOfSleepList, node_t_p_moveToSleepList);
+  
+  tcb_g_p_nextTaskBlock = tcb_sch_readyQueueHighest();
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_taskSleepTimeoutHandler                      */
+/*  Purpose:       Tell resources that blocked task has timed out.       */
+/*  Arguments:     Sch_Task* taskTCB:                                    */
+/*                           Pointer to task control block.              */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_OSsch_taskSleepTimeoutHandler(Sch_Task* taskTCB)
+{        
+  /* Task has timed out. Determine if due to manual sleep or resource */
+  switch(taskTCB->flags & (U1)SCH_TASK_RESOURCE_SLEEP_CHECK_MASK)
+  {
+    /* Remove task from resource's blocked list */
+#if(RTOS_CFG_OS_MAILBOX_ENABLED == RTOS_CONFIG_TRUE)
+    case (U1)SCH_TASK_FLAG_SLEEP_MBOX:
+      vd_OSmbox_blockedTaskTimeout((Mailbox*)taskTCB->resource);
+      taskTCB->resource = (void*)NULL;
+      break;
+#endif          
+#if(RTOS_CFG_OS_QUEUE_ENABLED == RTOS_CONFIG_TRUE)            
+    case (U1)SCH_TASK_FLAG_SLEEP_QUEUE:
+      vd_OSqueue_blockedTaskTimeout((Queue*)taskTCB->resource, taskTCB);
+      taskTCB->resource = (void*)NULL;
+      break;
+#endif   
+#if(RTOS_CFG_OS_SEMAPHORE_ENABLED == RTOS_CONFIG_TRUE)            
+    case (U1)SCH_TASK_FLAG_SLEEP_SEMA:
+      vd_OSsema_blockedTimeout((Semaphore*)taskTCB->resource, taskTCB);
+      taskTCB->resource = (void*)NULL;
+      break;
+#endif         
+#if(RTOS_CFG_OS_FLAGS_ENABLED == RTOS_CONFIG_TRUE)            
+    case (U1)SCH_TASK_FLAG_SLEEP_FLAGS:
+      vd_OSflags_pendTimeout((FlagsObj*)taskTCB->resource, taskTCB);
+      taskTCB->resource = (void*)NULL;
+      break;
+#endif         
+#if(RTOS_CFG_OS_MUTEX_ENABLED == RTOS_CONFIG_TRUE)
+    case (U1)SCH_TASK_FLAG_SLEEP_MUTEX:
+      vd_OSmutex_blockedTimeout((Mutex*)taskTCB->resource, taskTCB);
+      taskTCB->resource = (void*)NULL;
+      break;
+#endif    
+    case (U1)ZERO:
+      /* Manual sleep time out */
+      break;  
+
+    default:
+      OSTaskFault(); /* If code execution reaches this point it is a bug */
+      break;             
+  }          
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_periodicScheduler                            */
+/*  Purpose:       Scheduler algorithm called to check if task is ready. */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_TICK_TASK != RTOS_CONFIG_TRUE)
+static void vd_OSsch_periodicScheduler(void)
+{
+  if(node_s_p_headOfSleepList != (ListNode*)NULL)
+  {
+    /* Sleep list is a delta list. Only the head counter is relative to the current tick. */
+    --(node_s_p_headOfSleepList->TCB->sleepCntr);
+    
+    /* Wake every task that expires on this tick. Tasks behind an expired task with a zero delta expire together. */
+    while((node_s_p_headOfSleepList != (ListNode*)NULL) && (node_s_p_headOfSleepList->TCB->sleepCntr == (U4)ZERO))
+    {
+      vd_sch_sleepExpireHead();
+    }
+  }
+  else
+  {
+    /* No sleeping tasks to process. */  
+  } /* node_s_p_headOfSleepList != NULL */
+  
+#if(RTOS_CONFIG_ENABLE_ROUND_ROBIN == RTOS_CONFIG_TRUE)
+  /* Rotate current task within its priority level if its quantum expired. */
+  vd_sch_timeSlice();
+#endif
+  
+  /* Is highest priority ready task the same as before tick? */
+  if(tcb_sch_readyQueueHighest() == tcb_g_p_currentTaskBlock)
+  {  
+    /* Do nothing, return to current task. */
+  }
+  else
+  {
+    /* Set global task pointer to new task control block */
+    tcb_g_p_nextTaskBlock = tcb_sch_readyQueueHighest();
+
+    /* Set bit for pendSV to run when CPU is ready */
+    vd_sch_requestDispatch();
+  }
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_sch_sleepExpireHead                                */
+/*  Purpose:       Remove task at head of sleep list and make it ready.  */
+/*                 Resource task is blocked on is told of timeout. Call  */
+/*                 with interrupts disabled.                             */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_sleepExpireHead(void)
+{
+  ListNode* node_t_p_changeListNode;
+  Sch_Task* tcb_t_p_currentTCB;
+  
+  /* Remove from sleep list */
+  node_t_p_changeListNode = node_list_removeFirstNode(&node_s_p_headOfSleepList);
+  tcb_t_p_currentTCB      = node_t_p_changeListNode->TCB;
+  
+#if(RTOS_RESOURCES_CONFIGURED)  
+  vd_OSsch_taskSleepTimeoutHandler(tcb_t_p_currentTCB);
+#endif        
+  /* Update flags and wake reason to TIMEOUT */
+  tcb_t_p_currentTCB->wakeReason = (U1)SCH_TASK_WAKEUP_SLEEP_TIMEOUT;
+  tcb_t_p_currentTCB->flags     &= ~((U1)(SCH_TASK_FLAG_STS_SLEEP | SCH_TASK_RESOURCE_SLEEP_CHECK_MASK));
+  
+#if(RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE)
+  vd_OStrace_record((U1)TRACE_EVT_TASK_WAKE, tcb_t_p_currentTCB->taskID, (U1)SCH_TASK_WAKEUP_SLEEP_TIMEOUT);
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+  /* Compute deadline if this is a release and not a resource timeout. */
+  vd_sch_edfRelease(tcb_t_p_currentTCB);
+#endif
+  
+  /* Add to ready queue by priority. Task of exhausted partition waits for replenish instead. */
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+  if(u1_sch_partitionPark(node_t_p_changeListNode) == (U1)SCH_FALSE)
+#endif
+  {
+    vd_sch_readyQueueInsert(node_t_p_changeListNode);
+  }
+}
+
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+/*************************************************************************/
+/*  Function Name: vd_sch_readyQueueInsert                               */
+/*  Purpose:       Add task to ready queue by order of absolute deadline.*/
+/*                 O(n) in number of ready tasks.                        */
+/*  Arguments:     ListNode* node:                                       */
+/*                    Scheduler list node of task to be made ready.      */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_readyQueueInsert(ListNode* node)
+{
+  vd_list_addTaskByDeadline(&ReadyQ_s_readyQueue.deadlineList, node);
+}
+
+/*************************************************************************/
+/*  Function Name: vd_sch_readyQueueRemove                               */
+/*  Purpose:       Remove task from ready queue. O(1).                   */
+/*  Arguments:     ListNode* node:                                       */
+/*                    Scheduler list node of task to be removed.         */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_readyQueueRemove(ListNode* node)
+{
+  vd_list_removeNode(&ReadyQ_s_readyQueue.deadlineList, node);
+}
+
+/*************************************************************************/
+/*  Function Name: tcb_sch_readyQueueHighest                             */
+/*  Purpose:       Get ready task with earliest deadline. O(1).          */
+/*                 Background task never leaves ready queue so queue is  */
+/*                 never empty.                                          */
+/*  Arguments:     N/A                                                   */
+/*  Return:        Sch_Task*: TCB of ready task to run.                  */
+/*************************************************************************/
+static Sch_Task* tcb_sch_readyQueueHighest(void)
+{
+  return (ReadyQ_s_readyQueue.deadlineList->TCB);
+}
+
+/*************************************************************************/
+/*  Function Name: vd_sch_edfRelease                                     */
+/*  Purpose:       Set absolute deadline of woken task if it finished    */
+/*                 its previous job. Release is no earlier than one      */
+/*                 period after previous release. Must be called before  */
+/*                 task is added to ready queue.                         */
+/*  Arguments:     Sch_Task* taskTCB:                                    */
+/*                    Pointer to TCB of woken task.                      */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_edfRelease(Sch_Task* taskTCB)
+{
+  if(taskTCB->jobDone)
+  {
+    taskTCB->jobDone = (U1)SCH_FALSE;
+    
+    /* Task woken early cannot take an earlier deadline than its period allows. */
+    if((taskTCB->period != (U4)ZERO) && u1_OSsch_tickIsAfter(taskTCB->releaseTick + taskTCB->period, u4_s_tickCntr))
+    {
+      taskTCB->releaseTick += taskTCB->period;
+    }
+    else
+    {
+      taskTCB->releaseTick  = u4_s_tickCntr;
+    }
+    
+    /* Tasks without a deadline are ordered by priority, absolute deadline is unused. */
+    taskTCB->absDeadline = taskTCB->releaseTick + taskTCB->relDeadline;
+  }
+  else{}
+}
+
+/*************************************************************************/
+/*  Function Name: vd_sch_edfNewJob                                      */
+/*  Purpose:       Release next job of running task that finished its    */
+/*                 job without sleeping. Call with interrupts disabled.  */
+/*  Arguments:     ListNode* taskNode:                                   */
+/*                    Scheduler list node of task.                       */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_edfNewJob(ListNode* taskNode)
+{
+  vd_sch_readyQueueRemove(taskNode);
+  
+  taskNode->TCB->jobDone = (U1)SCH_TRUE;
+  vd_sch_edfRelease(taskNode->TCB);
+  
+  vd_sch_readyQueueInsert(taskNode);
+  
+  /* Later deadline may let another task run. */
+  if(tcb_sch_readyQueueHighest() != tcb_g_p_currentTaskBlock)
+  {
+    tcb_g_p_nextTaskBlock = tcb_sch_readyQueueHighest();
+    
+    vd_sch_requestDispatch();
+  }
+  else{}
+}
+
+#else
+/*************************************************************************/
+/*  Function Name: vd_sch_readyQueueInsert                               */
+/*  Purpose:       Add task to ready queue at its priority level. O(1).  */
+/*  Arguments:     ListNode* node:                                       */
+/*                    Scheduler list node of task to be made ready.      */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_readyQueueInsert(ListNode* node)
+{
+  U1 u1_t_prio;
+  U1 u1_t_group;
+  
+  u1_t_prio  = node->TCB->priority;
+  u1_t_group = u1_t_prio >> SCH_PRIO_GROUP_SHIFT;
+  
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+  /* Task raised to its threshold goes ahead of tasks at that level, which must not preempt it. */
+  if(node->TCB->basePriority != (U1)SCH_TASK_PRIORITY_UNDEFINED)
+  {
+  #if(RTOS_CONFIG_ENABLE_ROUND_ROBIN == RTOS_CONFIG_TRUE)
+    if(ReadyQ_s_readyQueue.prioTail[u1_t_prio] == (ListNode*)NULL)
+    {
+      ReadyQ_s_readyQueue.prioTail[u1_t_prio] = node;
+    }
+    else{}
+  #endif
+    vd_list_addNodeToFront(&ReadyQ_s_readyQueue.prioList[u1_t_prio], node);
+  }
+  else
+#endif
+  {
+#if(RTOS_CONFIG_ENABLE_ROUND_ROBIN == RTOS_CONFIG_TRUE)
+    /* FIFO within priority level. Running task stays at head until it yields or its slice expires. */
+    node->nextNode     = (ListNode*)NULL;
+    node->previousNode = ReadyQ_s_readyQueue.prioTail[u1_t_prio];
+    
+    if(ReadyQ_s_readyQueue.prioTail[u1_t_prio] == (ListNode*)NULL)
+    {
+      ReadyQ_s_readyQueue.prioList[u1_t_prio] = node;
+    }
+    else
+    {
+      ReadyQ_s_readyQueue.prioTail[u1_t_prio]->nextNode = node;
+    }
+    
+    ReadyQ_s_readyQueue.prioTail[u1_t_prio] = node;
+#elif(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+    /* Stay behind a task raised to this level. */
+    if((ReadyQ_s_readyQueue.prioList[u1_t_prio] != (ListNode*)NULL) && 
+       (ReadyQ_s_readyQueue.prioList[u1_t_prio]->TCB->basePriority != (U1)SCH_TASK_PRIORITY_UNDEFINED))
+    {
+      vd_list_addNodeToFront(&(ReadyQ_s_readyQueue.prioList[u1_t_prio]->nextNode), node);
+      node->previousNode = ReadyQ_s_readyQueue.prioList[u1_t_prio];
+    }
+    else
+    {
+      vd_list_addNodeToFront(&ReadyQ_s_readyQueue.prioList[u1_t_prio], node);
+    }
+#else
+    vd_list_addNodeToFront(&ReadyQ_s_readyQueue.prioList[u1_t_prio], node);
+#endif
+  }
+  
+  /* Mark priority level and its group as populated. */
+  ReadyQ_s_readyQueue.prioMap[u1_t_group] |= ((U4)SCH_PRIO_MAP_MSB >> (u1_t_prio & (U1)SCH_PRIO_GROUP_MASK));
+  ReadyQ_s_readyQueue.groupMap            |= ((U4)SCH_PRIO_MAP_MSB >> u1_t_group);
+}
+
+/*************************************************************************/
+/*  Function Name: vd_sch_readyQueueRemove                               */
+/*  Purpose:       Remove task from ready queue. O(1).                   */
+/*  Arguments:     ListNode* node:                                       */
+/*                    Scheduler list node of task to be removed.         */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_readyQueueRemove(ListNode* node)
+{
+  U1 u1_t_prio;
+  U1 u1_t_group;
+  
+  u1_t_prio  = node->TCB->priority;
+  u1_t_group = u1_t_prio >> SCH_PRIO_GROUP_SHIFT;
+  
+#if(RTOS_CONFIG_ENABLE_ROUND_ROBIN == RTOS_CONFIG_TRUE)
+  if(ReadyQ_s_readyQueue.prioTail[u1_t_prio] == node)
+  {
+    ReadyQ_s_readyQueue.prioTail[u1_t_prio] = node->previousNode;
+  }
+  else{}
+#endif
+  
+  vd_list_removeNode(&ReadyQ_s_readyQueue.prioList[u1_t_prio], node);
+  
+  /* Clear bitmap entries if no task is left at this priority level. */
+  if(ReadyQ_s_readyQueue.prioList[u1_t_prio] == (ListNode*)NULL)
+  {
+    ReadyQ_s_readyQueue.prioMap[u1_t_group] &= ~((U4)SCH_PRIO_MAP_MSB >> (u1_t_prio & (U1)SCH_PRIO_GROUP_MASK));
+    
+    if(ReadyQ_s_readyQueue.prioMap[u1_t_group] == (U4)ZERO)
+    {
+      ReadyQ_s_readyQueue.groupMap &= ~((U4)SCH_PRIO_MAP_MSB >> u1_t_group);
+    }
+    else{}
+  }
+  else{}
+}
+
+/*************************************************************************/
+/*  Function Name: tcb_sch_readyQueueHighest                             */
+/*  Purpose:       Get highest priority ready task. O(1). Background task*/
+/*                 never leaves ready queue so queue is never empty.     */
+/*  Arguments:     N/A                                                   */
+/*  Return:        Sch_Task*: TCB of highest priority ready task.        */
+/*************************************************************************/
+static Sch_Task* tcb_sch_readyQueueHighest(void)
+{
+  U1 u1_t_group;
+  U1 u1_t_prio;
+  
+  u1_t_group = OS_CPU_COUNT_LEADING_ZEROS(ReadyQ_s_readyQueue.groupMap);
+  u1_t_prio  = (U1)(u1_t_group << SCH_PRIO_GROUP_SHIFT) + OS_CPU_COUNT_LEADING_ZEROS(ReadyQ_s_readyQueue.prioMap[u1_t_group]);
+  
+  return (ReadyQ_s_readyQueue.prioList[u1_t_prio]->TCB);
+}
+#endif /* RTOS_CONFIG_ENABLE_EDF_SCHEDULING */
+
+/*************************************************************************/
+/*  Function Name: u1_sch_allocTaskSlot                                  */
+/*  Purpose:       Take lowest numbered free TCB slot. Caller must check */
+/*                 that a slot is free.                                  */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U1: Index of TCB slot.                                */
+/*************************************************************************/
+static U1 u1_sch_allocTaskSlot(void)
+{
+  U1 u1_t_word;
+  U1 u1_t_slot;
+  
+  u1_t_word = (U1)ZERO;
+  
+  while(u4_s_freeSlotMap[u1_t_word] == (U4)ZERO)
+  {
+    ++u1_t_word;
+  }
+  
+  u1_t_slot = (U1)(u1_t_word << SCH_SLOT_MAP_SHIFT) + OS_CPU_COUNT_LEADING_ZEROS(u4_s_freeSlotMap[u1_t_word]);
+  
+  u4_s_freeSlotMap[u1_t_word] &= ~((U4)SCH_PRIO_MAP_MSB >> (u1_t_slot & (U1)SCH_SLOT_MAP_MASK));
+  
+  return (u1_t_slot);
+}
+
+/*************************************************************************/
+/*  Function Name: vd_sch_freeTaskSlot                                   */
+/*  Purpose:       Return TCB slot to free slot map.                     */
+/*  Arguments:     U1 slot:                                              */
+/*                    Index of TCB slot.                                 */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_freeTaskSlot(U1 slot)
+{
+  u4_s_freeSlotMap[slot >> SCH_SLOT_MAP_SHIFT] |= ((U4)SCH_PRIO_MAP_MSB >> (slot & (U1)SCH_SLOT_MAP_MASK));
+}
+
+/*************************************************************************/
+/*  Function Name: vd_sch_taskUnlink                                     */
+/*  Purpose:       Remove task from resource blocked list and from ready */
+/*                 queue, sleep list or suspend list. Task state is      */
+/*                 reset. Call with interrupts disabled.                 */
+/*  Arguments:     ListNode* taskNode:                                   */
+/*                    Scheduler list node of task.                       */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_taskUnlink(ListNode* taskNode)
+{
+  Sch_Task* tcb_t_p_task;
+  
+  tcb_t_p_task = taskNode->TCB;
+  
+  /* If task is blocked on resource, then remove it from resource's blocked list. */
+  if(tcb_t_p_task->resource != SCH_NULL_PTR)
+  {
+    vd_OSsch_taskSleepTimeoutHandler(tcb_t_p_task);
+  }
+  else{}
+  
+  if(tcb_t_p_task->flags & (U1)SCH_TASK_FLAG_STS_SUSPENDED)
+  {
+    vd_list_removeNode(&node_s_p_headOfSuspendList, taskNode);
+  }
+  else if(tcb_t_p_task->flags & (U1)SCH_TASK_FLAG_STS_SLEEP)
+  {
+    vd_list_removeDeltaNode(&node_s_p_headOfSleepList, taskNode);
+  }
+  else
+  {
+    vd_sch_readyQueueRemove(taskNode);
+    
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+    vd_sch_thresholdLower(tcb_t_p_task);
+#endif
+  }
+  
+  tcb_t_p_task->flags     = (U1)ZERO;
+  tcb_t_p_task->sleepCntr = (U4)ZERO;
+  tcb_t_p_task->resource  = (void*)NULL;
+  
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+  tcb_t_p_task->throttled = (U1)SCH_FALSE;
+#endif
+#if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+  tcb_t_p_task->tableWait = (U1)SCH_FALSE;
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_PERIODIC_TASKS == RTOS_CONFIG_TRUE)
+  /* Restarted periodic task is released at once. Unfinished job is not counted. */
+  tcb_t_p_task->periodic.jobActive   = (U1)SCH_FALSE;
+  tcb_t_p_task->periodic.nextRelease = u4_s_tickCntr;
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_TASK_NOTIFY == RTOS_CONFIG_TRUE)
+  tcb_t_p_task->notifyValue = (U4)ZERO;
+  tcb_t_p_task->notifyState = (U1)SCH_NOTIFY_STATE_NOT_WAITING;
+#endif
+}
+
+/*************************************************************************/
+/*  Function Name: u1_sch_priorityInUse                                  */
+/*  Purpose:       Check if a task other than given task has priority,   */
+/*                 as assigned or currently held. Call with interrupts   */
+/*                 disabled.                                             */
+/*  Arguments:     U1 priority:                                          */
+/*                    Priority level to check.                           */
+/*                 Sch_Task* exceptTCB:                                  */
+/*                    Task that is not checked.                          */
+/*  Return:        SCH_TRUE if priority is used, otherwise SCH_FALSE.    */
+/*************************************************************************/
+#if((RTOS_CONFIG_ENABLE_DYNAMIC_PRIORITY == RTOS_CONFIG_TRUE) && (RTOS_CONFIG_ENABLE_ROUND_ROBIN != RTOS_CONFIG_TRUE))
+static U1 u1_sch_priorityInUse(U1 priority, Sch_Task* exceptTCB)
+{
+  U1 u1_t_index;
+  U1 u1_t_inUse;
+  
+  u1_t_inUse = (U1)SCH_FALSE;
+  
+  for(u1_t_index = (U1)ZERO; u1_t_index < (U1)SCH_MAX_NUM_TASKS; u1_t_index++)
+  {
+    if((&SchTask_s_as_taskList[u1_t_index] != exceptTCB) && (SchTask_s_as_taskList[u1_t_index].taskID != (U1)SCH_INVALID_TASK_ID) &&
+       ((SchTask_s_as_taskList[u1_t_index].priority == priority) || (SchTask_s_as_taskList[u1_t_index].assignedPriority == priority)))
+    {
+      u1_t_inUse = (U1)SCH_TRUE;
+    }
+    else{}
+  }
+  
+  return (u1_t_inUse);
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: u1_sch_taskHoldsResource                              */
+/*  Purpose:       Check if task owns a resource that is lost if task is */
+/*                 deleted or restarted: a mutex, or scheduler lock of   */
+/*                 current task. Call with interrupts disabled.          */
+/*  Arguments:     Sch_Task* taskTCB:                                    */
+/*                    Pointer to TCB of task.                            */
+/*  Return:        SCH_TRUE   OR                                         */
+/*                 SCH_FALSE                                             */
+/*************************************************************************/
+static U1 u1_sch_taskHoldsResource(Sch_Task* taskTCB)
+{
+  U1 u1_t_holds;
+  
+  u1_t_holds = (U1)((taskTCB == tcb_s_p_schLockOwner) && (u1_s_schLockNest != (U1)ZERO));
+  
+#if(RTOS_CFG_OS_MUTEX_ENABLED == RTOS_CONFIG_TRUE)
+  if(u1_OSmutex_getNumHeld(taskTCB) != (U1)ZERO)
+  {
+    u1_t_holds = (U1)SCH_TRUE;
+  }
+  else{}
+#endif
+  
+  return (u1_t_holds);
+}
+
+/*************************************************************************/
+/*  Function Name: vd_sch_taskRelease                                    */
+/*  Purpose:       Move sleeping or suspended task to ready queue. Does  */
+/*                 not check for preemption. Call with interrupts        */
+/*                 disabled.                                             */
+/*  Arguments:     ListNode* taskNode:                                   */
+/*                    Scheduler list node of task.                       */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_taskRelease(ListNode* taskNode)
+{
+  /* If task is blocked on resource, then tell resource that task has timed out. */
+  if(taskNode->TCB->resource != SCH_NULL_PTR)
+  {
+    vd_OSsch_taskSleepTimeoutHandler(taskNode->TCB);
+  }
+  else
+  {
+    /* Task not blocked on resource. */
+  }
+  
+  /* Remove task from suspend list or sleep list */
+  if(taskNode->TCB->flags & (U1)SCH_TASK_FLAG_STS_SUSPENDED)
+  {
+    vd_list_removeNode(&node_s_p_headOfSuspendList, taskNode);
+  }
+  else
+  {
+    vd_list_removeDeltaNode(&node_s_p_headOfSleepList, taskNode);
+  }
+  
+  taskNode->TCB->sleepCntr  =   (U4)ZERO; 
+  taskNode->TCB->flags     &= ~((U1)(SCH_TASK_FLAG_STS_SLEEP|SCH_TASK_FLAG_STS_SUSPENDED));
+  
+#if(RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE)
+  vd_OStrace_record((U1)TRACE_EVT_TASK_WAKE, taskNode->TCB->taskID, taskNode->TCB->wakeReason);
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+  /* Compute deadline if this is a release and not a resource wake. */
+  vd_sch_edfRelease(taskNode->TCB);
+#endif
+  
+  /* Add woken task to ready queue. Task of exhausted partition waits for replenish instead. */
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+  if(u1_sch_partitionPark(taskNode) == (U1)SCH_FALSE)
+#endif
+  {
+    vd_sch_readyQueueInsert(taskNode);
+  }
+}
+
+/*************************************************************************/
+/*  Function Name: vd_sch_taskWake                                       */
+/*  Purpose:       Wake task from sleep or suspended state and check for */
+/*                 preemption. Call with interrupts disabled.            */
+/*  Arguments:     ListNode* taskNode:                                   */
+/*                    Scheduler list node of task.                       */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_taskWake(ListNode* taskNode)
+{  
+  /* Check that task is not already in ready state. */
+  if(taskNode->TCB->flags & (U1)SCH_TASK_FLAG_STS_CHECK)
+  {
+#if(RTOS_CONFIG_CALC_TASK_CPU_LOAD == RTOS_CONFIG_TRUE)
+    /* Check if CPU was previously idle, make calculation if so. */
+    if(tcb_g_p_currentTaskBlock == (Node_s_ap_mapTaskIDToTCB[SCH_BG_TASK_ID]->TCB))
+    {
+      OS_s_cpuData.CPUIdlePercent.CPU_idleRunning += (u1_cpu_getPercentOfTick() - OS_s_cpuData.CPUIdlePercent.CPU_idlePrevTimestamp);
+    }
+    else {}
+#endif
+    
+    vd_sch_taskRelease(taskNode);
+    
+    /* Is woken up task higher priority than current task ? */
+    if(tcb_sch_readyQueueHighest() != tcb_g_p_currentTaskBlock)
+    { 
+      /* Set global task pointer to new task control block */
+      tcb_g_p_nextTaskBlock = tcb_sch_readyQueueHighest();
+      
+      vd_sch_requestDispatch();
+    }
+    else
+    {
+      
+    }
+  }
+  else
+  {
+    /* Task is not in sleep or suspended state. Do nothing. */
+  }/* taskNode->TCB->flags & (U1)SCH_TASK_FLAG_STS_CHECK */
+}
+
+/*************************************************************************/
+/*  Function Name: vd_sch_taskSuspend                                    */
+/*  Purpose:       Move task to suspend list. Dispatch is triggered if   */
+/*                 task is current task. Call with interrupts disabled.  */
+/*  Arguments:     ListNode* taskNode:                                   */
+/*                    Scheduler list node of task.                       */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_taskSuspend(ListNode* taskNode)
+{
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+  /* Suspension is now owned by caller and is not undone by budget replenish. */
+  taskNode->TCB->throttled = (U1)SCH_FALSE;
+#endif
+#if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+  /* Nor by a table release. Table wait marks task after this call. */
+  taskNode->TCB->tableWait = (U1)SCH_FALSE;
+#endif
+  
+#if(RTOS_CONFIG_ENABLE_EDF_SCHEDULING == RTOS_CONFIG_TRUE)
+  /* Task suspending itself has finished its job. Wake is a release. */
+  if(taskNode->TCB == tcb_g_p_currentTaskBlock)
+  {
+    taskNode->TCB->jobDone = (U1)SCH_TRUE;
+  }
+  else{}
+#endif
+  
+  if((taskNode->TCB->flags & (U1)SCH_TASK_FLAG_STS_SUSPENDED) == (U1)ZERO)
+  {
+    /* Sleeping task no longer times out once suspended. */
+    if(taskNode->TCB->flags & (U1)SCH_TASK_FLAG_STS_SLEEP)
+    {
+      vd_list_removeDeltaNode(&node_s_p_headOfSleepList, taskNode);
+    }
+    else
+    {
+      vd_sch_readyQueueRemove(taskNode); 
+      
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+      vd_sch_thresholdLower(taskNode->TCB);
+#endif
+    }
+    
+    taskNode->TCB->flags |= (U1)SCH_TASK_FLAG_STS_SUSPENDED;
+    vd_list_addNodeToFront(&node_s_p_headOfSuspendList, taskNode); 
+  }
+  else{}
+
+  /* Is task suspending itself or another task? */
+  if(taskNode->TCB == tcb_g_p_currentTaskBlock)
+  {
+    /* Switch to an active task */
+    tcb_g_p_nextTaskBlock = tcb_sch_readyQueueHighest();
+    OS_CPU_TRIGGER_DISPATCHER();
+  }
+  else{}
+}
+
+/*************************************************************************/
+/*  Function Name: vd_sch_priorityChange                                 */
+/*  Purpose:       Move task to new priority level and check for         */
+/*                 preemption. Call with interrupts disabled.            */
+/*  Arguments:     Sch_Task* tcb:                                        */
+/*                    Pointer to TCB to have priority changed.           */
+/*                 U1 newPriority:                                       */
+/*                    New priority level.                                */
+/*                 U1 cause:                                             */
+/*                    Reason for change, recorded in priority trace.     */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_priorityChange(Sch_Task* tcb, U1 newPriority, U1 cause)
+{
+#if(RTOS_CONFIG_ENABLE_PRIORITY_TRACE == RTOS_CONFIG_TRUE)
+  vd_sch_priorityTraceRecord(tcb, newPriority, cause);
+#else
+  (void)cause;
+#endif
+  
+  /* If task is suspended or sleeping then simply change priority. */
+  if(tcb->flags & (U1)SCH_TASK_FLAG_STS_CHECK)
+  {
+    tcb->priority = newPriority;
+  }
+  else
+  {
+    /* Remove node from current priority level. */
+    vd_sch_readyQueueRemove(Node_s_ap_mapTaskIDToTCB[tcb->taskID]);
+    
+    /* Change priority. */
+    tcb->priority = newPriority;
+    
+    /* Add back into ready queue at new priority level. */
+    vd_sch_readyQueueInsert(Node_s_ap_mapTaskIDToTCB[tcb->taskID]);
+    
+    /* Is new priority higher priority than current task ? */
+    if(tcb_sch_readyQueueHighest() != tcb_g_p_currentTaskBlock)
+    { 
+      /* Set global task pointer to new task control block */
+      tcb_g_p_nextTaskBlock = tcb_sch_readyQueueHighest();
+      
+      vd_sch_requestDispatch();
+    }
+    else
+    {
+      
+    }
+  }
+}
+
+/*************************************************************************/
+/*  Function Name: vd_sch_priorityTraceRecord                            */
+/*  Purpose:       Add priority change to trace buffer. Oldest entry is  */
+/*                 overwritten if full. Call with interrupts disabled.   */
+/*  Arguments:     Sch_Task* tcb:                                        */
+/*                    Pointer to TCB of task.                            */
+/*                 U1 newPriority:                                       */
+/*                    New priority level.                                */
+/*                 U1 cause:                                             */
+/*                    Reason for change.                                 */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PRIORITY_TRACE == RTOS_CONFIG_TRUE)
+static void vd_sch_priorityTraceRecord(Sch_Task* tcb, U1 newPriority, U1 cause)
+{
+  U1 u1_t_index;
+  
+  u1_t_index = u1_s_prioTraceHead + u1_s_prioTraceCount;
+  
+  if(u1_t_index >= (U1)SCH_PRIO_TRACE_SIZE)
+  {
+    u1_t_index -= (U1)SCH_PRIO_TRACE_SIZE;
+  }
+  else{}
+  
+  PrioTrace_s_as_buffer[u1_t_index].tick        = u4_s_tickCntr;
+  PrioTrace_s_as_buffer[u1_t_index].taskID      = tcb->taskID;
+  PrioTrace_s_as_buffer[u1_t_index].oldPriority = tcb->priority;
+  PrioTrace_s_as_buffer[u1_t_index].newPriority = newPriority;
+  PrioTrace_s_as_buffer[u1_t_index].cause       = cause;
+  
+  /* Buffer full. Drop oldest entry. */
+  if(u1_s_prioTraceCount == (U1)SCH_PRIO_TRACE_SIZE)
+  {
+    if(++u1_s_prioTraceHead >= (U1)SCH_PRIO_TRACE_SIZE)
+    {
+      u1_s_prioTraceHead = (U1)ZERO;
+    }
+    else{}
+  }
+  else
+  {
+    ++u1_s_prioTraceCount;
+  }
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_sch_discardCurrentContext                          */
+/*  Purpose:       Switch away from running task without saving its     */
+/*                 context in its TCB. Running task must already be      */
+/*                 removed from ready queue. Call with interrupts        */
+/*                 disabled.                                             */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_discardCurrentContext(void)
+{
+  tcb_g_p_currentTaskBlock = &SchTask_s_discardedContext;
+  tcb_g_p_nextTaskBlock    = tcb_sch_readyQueueHighest();
+  
+  OS_CPU_TRIGGER_DISPATCHER();
+}
+
+/*************************************************************************/
+/*  Function Name: vd_sch_requestDispatch                                */
+/*  Purpose:       Trigger dispatcher to preempt current task, or record */
+/*                 request if current task holds scheduler lock. Task    */
+/*                 that is leaving ready state is always switched out.   */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_requestDispatch(void)
+{
+  if((u1_s_schLockNest != (U1)ZERO) && (tcb_s_p_schLockOwner == tcb_g_p_currentTaskBlock) &&
+     ((tcb_g_p_currentTaskBlock->flags & (U1)SCH_TASK_FLAG_STS_CHECK) == (U1)ZERO))
+  {
+    u1_s_dispatchPending = (U1)SCH_TRUE;
+  }
+  else
+  {
+    OS_CPU_TRIGGER_DISPATCHER();
+  }
+}
+
+/*************************************************************************/
+/*  Function Name: vd_sch_taskReturn                                     */
+/*  Purpose:       Entered when a task routine returns. Run-to-completion*/
+/*                 task goes back to suspend list to wait for its next   */
+/*                 activation, other tasks are deleted.                  */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_taskReturn(void)
+{
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+  ListNode* node_t_p_task;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  OS_CPU_ENTER_CRITICAL();
+  
+  if(tcb_g_p_currentTaskBlock->sharedStack)
+  {
+    node_t_p_task = Node_s_ap_mapTaskIDToTCB[tcb_g_p_currentTaskBlock->taskID];
+    
+    vd_sch_readyQueueRemove(node_t_p_task);
+    vd_sch_thresholdLower(tcb_g_p_currentTaskBlock);
+    
+    tcb_g_p_currentTaskBlock->flags   |= (U1)SCH_TASK_FLAG_STS_SUSPENDED;
+    vd_list_addNodeToFront(&node_s_p_headOfSuspendList, node_t_p_task);
+    
+    /* Stack frame is built again on next activation. */
+    tcb_g_p_currentTaskBlock->stackPtr = (OS_STACK*)NULL;
+    vd_sch_discardCurrentContext();
+  }
+  else
+  {
+    (void)u1_OSsch_taskDelete(tcb_g_p_currentTaskBlock->taskID);
+  }
+  
+  OS_CPU_EXIT_CRITICAL();
+#else
+  (void)u1_OSsch_taskDelete(tcb_g_p_currentTaskBlock->taskID);
+#endif
+  
+  /* Reached if task returned while holding a mutex or scheduler lock, otherwise it is a bug. */
+  OSTaskFault();
+}
+
+/*************************************************************************/
+/*  Function Name: vd_sch_thresholdRaise                                 */
+/*  Purpose:       Raise priority of task that is entering run state to  */
+/*                 its preemption threshold. Task must be in ready queue.*/
+/*  Arguments:     ListNode* node:                                       */
+/*                    Scheduler list node of task.                       */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+static void vd_sch_thresholdRaise(ListNode* node)
+{
+  Sch_Task* tcb_t_p_task;
+  
+  tcb_t_p_task = node->TCB;
+  
+  /* Not raised again if already raised or if priority inheritance put task above its threshold. */
+  if((tcb_t_p_task->basePriority == (U1)SCH_TASK_PRIORITY_UNDEFINED) && (tcb_t_p_task->preemptThreshold < tcb_t_p_task->priority))
+  {
+    vd_sch_readyQueueRemove(node);
+    
+    tcb_t_p_task->basePriority = tcb_t_p_task->priority;
+    tcb_t_p_task->priority     = tcb_t_p_task->preemptThreshold;
+    
+    vd_sch_readyQueueInsert(node);
+  }
+  else{}
+}
+
+/*************************************************************************/
+/*  Function Name: vd_sch_thresholdLower                                 */
+/*  Purpose:       Restore priority of task leaving run state. Task must */
+/*                 not be in ready queue.                                */
+/*  Arguments:     Sch_Task* taskTCB:                                    */
+/*                    Pointer to TCB of task.                            */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_sch_thresholdLower(Sch_Task* taskTCB)
+{
+  if(taskTCB->basePriority != (U1)SCH_TASK_PRIORITY_UNDEFINED)
+  {
+    /* Keep priority if it was changed by priority inheritance while raised. */
+    if(taskTCB->priority == taskTCB->preemptThreshold)
+    {
+      taskTCB->priority = taskTCB->basePriority;
+    }
+    else{}
+    
+    taskTCB->basePriority = (U1)SCH_TASK_PRIORITY_UNDEFINED;
+  }
+  else{}
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_sch_timeSlice                                      */
+/*  Purpose:       Count down time quantum of running task and rotate it */
+/*                 to tail of its priority level when quantum expires.   */
+/*                 Called from tick ISR when tick task is enabled.       */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_ROUND_ROBIN == RTOS_CONFIG_TRUE)
+static void vd_sch_timeSlice(void)
+{
+  ListNode* node_t_p_current;
+  
+  /* New task has been dispatched since last tick. Start a fresh quantum. */
+  if(tcb_g_p_currentTaskBlock != tcb_s_p_sliceOwner)
+  {
+    tcb_s_p_sliceOwner = tcb_g_p_currentTaskBlock;
+    u4_s_sliceCntr     = (U4)SCH_TIME_SLICE_TICKS;
+  }
+  else{}
+  
+  /* Task may have just blocked with dispatch still pending. Only rotate tasks in ready queue. */
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+  /* Task raised to its threshold cannot be preempted by tasks sharing that level. */
+  if(((tcb_g_p_currentTaskBlock->flags & (U1)SCH_TASK_FLAG_STS_CHECK) == (U1)ZERO) &&
+      (tcb_g_p_currentTaskBlock->basePriority == (U1)SCH_TASK_PRIORITY_UNDEFINED))
+#else
+  if((tcb_g_p_currentTaskBlock->flags & (U1)SCH_TASK_FLAG_STS_CHECK) == (U1)ZERO)
+#endif
+  {
+    if(--u4_s_sliceCntr == (U4)ZERO)
+    {
+      u4_s_sliceCntr   = (U4)SCH_TIME_SLICE_TICKS;
+      node_t_p_current = Node_s_ap_mapTaskIDToTCB[tcb_g_p_currentTaskBlock->taskID];
+      
+      /* Only rotate if another task shares this priority level. */
+      if(ReadyQ_s_readyQueue.prioList[tcb_g_p_currentTaskBlock->priority]->nextNode != (ListNode*)NULL)
+      {
+        vd_sch_readyQueueRemove(node_t_p_current);
+        vd_sch_readyQueueInsert(node_t_p_current);
+      }
+      else{}
+    }
+    else{}
+  }
+  else{}
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_OSsch_background                                   */
+/*  Purpose:       Background task when no others are scheduled.         */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+static void vd_OSsch_background(void)
+{
+#if(SCH_STACK_LIMIT_MARK == RTOS_CONFIG_TRUE)
+  U1 u1_t_index;
+#endif
+#if(RTOS_CONFIG_ENABLE_IDLE_JOBS == RTOS_CONFIG_TRUE)
+  U1 u1_t_jobsPending;
+#endif
+
+  for(;;)
+  {     
+#if(SCH_STACK_LIMIT_MARK == RTOS_CONFIG_TRUE)
+    for(u1_t_index = ZERO; u1_t_index < (U1)SCH_MAX_NUM_TASKS; u1_t_index++)
+    {
+      /* Skip unused TCB slots. */
+      if((SchTask_s_as_taskList[u1_t_index].taskID != (U1)SCH_INVALID_TASK_ID) && u1_sch_checkStack(u1_t_index))
+      {
+        OSTaskFault();
+      }
+      else{}
+    }
+#endif
+#if(RTOS_CONFIG_ENABLE_STACK_WATERMARK == RTOS_CONFIG_TRUE)
+    vd_sch_stackScan();
+#endif
+#if(RTOS_CFG_OS_MEM_ENABLED == RTOS_CONFIG_TRUE)
+    if(u1_OSMem_maintenance())
+    {
+      OSTaskFault();
+    }
+    else{}
+#endif    
+#if(RTOS_CONFIG_ENABLE_IDLE_JOBS == RTOS_CONFIG_TRUE)
+    u1_t_jobsPending = u1_sch_idleJobsRun();
+    
+    /* Do not sleep while jobs are left. Checks above are made again before more steps are run. */
+    if(u1_t_jobsPending)
+    {
+      continue;
+    }
+    else{}
+#endif
+#if (RTOS_CONFIG_CALC_TASK_CPU_LOAD == RTOS_CONFIG_TRUE)
+    OS_s_cpuData.CPUIdlePercent.CPU_idlePrevTimestamp = u1_cpu_getPercentOfTick();
+#endif
+    
+#if(RTOS_CONFIG_ENABLE_TICKLESS_IDLE == RTOS_CONFIG_TRUE)
+    vd_sch_ticklessIdle();
+#elif(RTOS_CONFIG_ENABLE_BACKGROUND_IDLE_SLEEP == RTOS_CONFIG_TRUE)
+  #if(RTOS_CONFIG_PRESLEEP_FUNC == RTOS_CONFIG_TRUE || RTOS_CONFIG_POSTSLEEP_FUNC == RTOS_CONFIG_TRUE)
+    u1_s_sleepState = (U1)SCH_CPU_SLEEPING;
+  #endif
+  #if(RTOS_CONFIG_PRESLEEP_FUNC == RTOS_CONFIG_TRUE)
+    /* pre-sleep hook function defined by application */
+    app_OSPreSleepFcn();
+  #endif
+    WaitForInterrupt();
+#endif
+  }
+}
+
+/*************************************************************************/
+/*  Function Name: u1_sch_idleJobsRun                                    */
+/*  Purpose:       Run steps of queued idle jobs, oldest job first,      */
+/*                 until queue is empty or cycle budget is used. Steps   */
+/*                 run with interrupts enabled. Called by background     */
+/*                 task only.                                            */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U1: SCH_TRUE if jobs are left in queue.               */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_IDLE_JOBS == RTOS_CONFIG_TRUE)
+static U1 u1_sch_idleJobsRun(void)
+{
+  U4         u4_t_startCycles;
+  OSIdleJob* job_t_p_job;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u4_t_startCycles = OS_CPU_GET_CYCLE_COUNT();
+  
+  /* Head is only removed here, so it can be read without a critical section. Posts only change tail. */
+  while((Job_s_p_idleJobHead != (OSIdleJob*)NULL) && 
+        ((U4)(OS_CPU_GET_CYCLE_COUNT() - u4_t_startCycles) < (U4)RTOS_CONFIG_IDLE_JOB_BUDGET_CYCLES))
+  {
+    job_t_p_job = Job_s_p_idleJobHead;
+    
+    if(job_t_p_job->step(job_t_p_job->arg) == (U1)SCH_IDLE_JOB_DONE)
+    {
+      OS_CPU_ENTER_CRITICAL();
+      
+      Job_s_p_idleJobHead = job_t_p_job->next;
+      
+      if(Job_s_p_idleJobHead == (OSIdleJob*)NULL)
+      {
+        Job_s_p_idleJobTail = (OSIdleJob*)NULL;
+      }
+      else{}
+      
+      /* Job may be posted again. */
+      job_t_p_job->queued = (U1)SCH_FALSE;
+      
+      OS_CPU_EXIT_CRITICAL();
+    }
+    else{}
+  }
+  
+  return ((U1)(Job_s_p_idleJobHead != (OSIdleJob*)NULL));
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_sch_ticklessIdle                                   */
+/*  Purpose:       Put CPU to sleep with SysTick stretched up to the next*/
+/*                 scheduled wake-up, then correct tick count on wake.   */
+/*                 Hook functions run with interrupts disabled.          */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_TICKLESS_IDLE == RTOS_CONFIG_TRUE)
+static void vd_sch_ticklessIdle(void)
+{
+  U4 u4_t_idleTicks;
+  U4 u4_t_suppressedTicks;
+  U4 u4_t_elapsedTicks;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  /* Sleep wakes on a pending interrupt, which runs once the critical section is exited. */
+  OS_CPU_ENTER_CRITICAL();
+  
+  /* A task may have been woken by an interrupt since background task was dispatched. */
+  if(tcb_sch_readyQueueHighest() == tcb_g_p_currentTaskBlock)
+  {
+    if(node_s_p_headOfSleepList == (ListNode*)NULL)
+    {
+      u4_t_idleTicks = (U4)SCH_TICKLESS_NO_WAKEUP_PENDING;
+    }
+    else
+    {
+      /* Head of delta list holds ticks until next wake-up. */
+      u4_t_idleTicks = node_s_p_headOfSleepList->TCB->sleepCntr;
+    }
+    
+  #if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+    /* Wake for next table release. */
+    if(u4_t_idleTicks > u4_sch_scheduleTableTicksToNext())
+    {
+      u4_t_idleTicks = u4_sch_scheduleTableTicksToNext();
+    }
+    else{}
+  #endif
+  #if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+    /* Throttled tasks are resumed at end of major frame. */
+    if((u4_s_partitionThrottleMask != (U4)ZERO) && (u4_t_idleTicks > u4_s_partitionFrameTicks))
+    {
+      u4_t_idleTicks = u4_s_partitionFrameTicks;
+    }
+    else{}
+  #endif
+    
+  #if(RTOS_CONFIG_ENABLE_IDLE_GOVERNOR == RTOS_CONFIG_TRUE)
+    /* Scheduled wake-up is an upper bound. Interrupts have recently ended idle early by the correction factor. */
+    u1_s_idleSleepState = u1_sch_idleSelectState(u4_sch_idleTicksToUs((U4)(((U8)u4_t_idleTicks * u4_s_idleCorrection) >> SCH_IDLE_CORRECTION_SHIFT)));
+  #endif
+  #if(RTOS_CONFIG_PRESLEEP_FUNC == RTOS_CONFIG_TRUE || RTOS_CONFIG_POSTSLEEP_FUNC == RTOS_CONFIG_TRUE)
+    u1_s_sleepState = (U1)SCH_CPU_SLEEPING;
+  #endif
+  #if(RTOS_CONFIG_PRESLEEP_FUNC == RTOS_CONFIG_TRUE)
+    /* pre-sleep hook function defined by application */
+    app_OSPreSleepFcn();
+  #endif
+  
+    if(u4_t_idleTicks >= (U4)SCH_TICKLESS_MIN_IDLE_TICKS)
+    {
+      u4_t_suppressedTicks = u4_cpu_tickSuppress(u4_t_idleTicks);
+      OS_CPU_CRITICAL_WAIT_FOR_INTERRUPT();
+      u4_t_elapsedTicks = u4_cpu_tickResume(u4_t_suppressedTicks);
+      vd_sch_tickAdvance(u4_t_elapsedTicks);
+      
+      /* Tick in progress when CPU woke is counted as idle. */
+      ++u4_t_elapsedTicks;
+    }
+    else
+    {
+      /* Next wake-up is on the next tick. Sleep without reprogramming SysTick. */
+      OS_CPU_CRITICAL_WAIT_FOR_INTERRUPT();
+      u4_t_elapsedTicks = (U4)ONE;
+    }
+    
+  #if(RTOS_CONFIG_ENABLE_IDLE_GOVERNOR == RTOS_CONFIG_TRUE)
+    vd_sch_idleGovernorUpdate(u4_t_idleTicks, u4_t_elapsedTicks);
+  #endif
+    
+  #if(RTOS_CONFIG_POSTSLEEP_FUNC == RTOS_CONFIG_TRUE)
+    /* post-sleep hook function defined by application */
+    app_OSPostSleepFcn();
+  #endif
+  #if(RTOS_CONFIG_PRESLEEP_FUNC == RTOS_CONFIG_TRUE || RTOS_CONFIG_POSTSLEEP_FUNC == RTOS_CONFIG_TRUE)
+    u1_s_sleepState = (U1)SCH_CPU_NOT_SLEEPING;
+  #endif
+  }
+  else{}
+  
+  /* Pending interrupt that woke CPU runs here. */
+  OS_CPU_EXIT_CRITICAL();
+}
+
+/*************************************************************************/
+/*  Function Name: u1_sch_idleSelectState                                */
+/*  Purpose:       Choose sleep state of lowest power cost whose latency */
+/*                 is below idle length. Uses no hardware, so it can be  */
+/*                 run on a host with simulated states.                  */
+/*  Arguments:     U4 idleUs:                                            */
+/*                    Idle length in microseconds.                       */
+/*  Return:        U1: State ID   OR                                     */
+/*                 SCH_SLEEP_STATE_NONE if no state is valid.            */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_IDLE_GOVERNOR == RTOS_CONFIG_TRUE)
+static U1 u1_sch_idleSelectState(U4 idleUs)
+{
+  U1 u1_t_index;
+  U1 u1_t_state;
+  
+  u1_t_state = (U1)SCH_SLEEP_STATE_NONE;
+  
+  for(u1_t_index = (U1)ZERO; u1_t_index < (U1)SCH_NUM_SLEEP_STATES; u1_t_index++)
+  {
+    if((SleepState_s_as_states[u1_t_index].registered) && (SleepState_s_as_states[u1_t_index].latencyUs < idleUs))
+    {
+      if((u1_t_state == (U1)SCH_SLEEP_STATE_NONE) || 
+         (SleepState_s_as_states[u1_t_index].powerCost < SleepState_s_as_states[u1_t_state].powerCost))
+      {
+        u1_t_state = u1_t_index;
+      }
+      else{}
+    }
+    else{}
+  }
+  
+  return (u1_t_state);
+}
+
+/*************************************************************************/
+/*  Function Name: u4_sch_idleTicksToUs                                  */
+/*  Purpose:       Convert ticks to microseconds, saturating.            */
+/*  Arguments:     U4 ticks:                                             */
+/*                    Number of ticks.                                   */
+/*  Return:        U4: Microseconds.                                     */
+/*************************************************************************/
+static U4 u4_sch_idleTicksToUs(U4 ticks)
+{
+  U8 u8_t_us;
+  
+  u8_t_us = (U8)ticks * u4_s_tickPeriodUs;
+  
+  return ((u8_t_us > (U8)MAX_VAL_4BYTE) ? (U4)MAX_VAL_4BYTE : (U4)u8_t_us);
 }
-#endif
 
 /*************************************************************************/
-/*  Function Name: vd_OSsch_setNewTickPeriod                             */
-/*  Purpose:       Set new tick period in milliseconds.                  */
-/*  Arguments:     U4 numMsReload:                                       */
-/*                    Period of interrupts.                              */
+/*  Function Name: vd_sch_idleGovernorUpdate                             */
+/*  Purpose:       Record residency and misprediction of chosen state,   */
+/*                 and update correction factor of idle prediction.      */
+/*  Arguments:     U4 scheduledTicks:                                    */
+/*                    Ticks until next scheduled wake-up at sleep entry. */
+/*                 U4 actualTicks:                                       */
+/*                    Ticks CPU was idle.                                */
 /*  Return:        N/A                                                   */
 /*************************************************************************/
-void vd_OSsch_setNewTickPeriod(U4 numMsReload)
+static void vd_sch_idleGovernorUpdate(U4 scheduledTicks, U4 actualTicks)
 {
-  vd_cpu_setNewSchedPeriod(numMsReload);
+  U4              u4_t_actualUs;
+  U4              u4_t_ratio;
+  U1              u1_t_bestState;
+  Sch_SleepState* sleep_t_p_state;
+  
+  u4_t_actualUs = u4_sch_idleTicksToUs(actualTicks);
+  
+  if(u1_s_idleSleepState != (U1)SCH_SLEEP_STATE_NONE)
+  {
+    sleep_t_p_state = &SleepState_s_as_states[u1_s_idleSleepState];
+    
+    ++sleep_t_p_state->entries;
+    sleep_t_p_state->residencyTicks += actualTicks;
+    
+    if(u4_t_actualUs <= sleep_t_p_state->latencyUs)
+    {
+      ++sleep_t_p_state->tooDeep;
+    }
+    else
+    {
+      /* State that would have been chosen had idle length been known. */
+      u1_t_bestState = u1_sch_idleSelectState(u4_t_actualUs);
+      
+      if(SleepState_s_as_states[u1_t_bestState].powerCost < sleep_t_p_state->powerCost)
+      {
+        ++sleep_t_p_state->tooShallow;
+      }
+      else{}
+    }
+  }
+  else{}
+  
+  /* Idle with no scheduled wake-up says nothing about how early interrupts end a scheduled idle. */
+  if(scheduledTicks != (U4)SCH_TICKLESS_NO_WAKEUP_PENDING)
+  {
+    if(actualTicks >= scheduledTicks)
+    {
+      u4_t_ratio = (U4)SCH_IDLE_CORRECTION_ONE;
+    }
+    else
+    {
+      u4_t_ratio = (U4)(((U8)actualTicks << SCH_IDLE_CORRECTION_SHIFT) / scheduledTicks);
+    }
+    
+    u4_s_idleCorrection = u4_s_idleCorrection - (u4_s_idleCorrection >> SCH_IDLE_CORRECTION_WEIGHT_SHIFT) + (u4_t_ratio >> SCH_IDLE_CORRECTION_WEIGHT_SHIFT);
+  }
+  else{}
 }
+#endif
 
 /*************************************************************************/
-/*  Function Name: vd_OSsch_setReasonForWakeup                           */
-/*  Purpose:       Set reason for wakeup to resource available. Called   */
-/*                 internal to RTOS by other RTOS modules. It is expected*/
-/*                 that OS internal modules will call taskWake() *after* */
-/*                 this function call and maintain their own block lists.*/
-/*  Arguments:     U1 reason:                                            */
-/*                    Identifier code for wakeup reason.                 */
-/*                 Sch_Task* wakeupTaskTCB:                              */
-/*                    Pointer to task TCB that is being woken up which   */
-/*                    was stored on resource blocked list.               */
-/*  Return:        void                                                  */
+/*  Function Name: vd_sch_tickAdvance                                    */
+/*  Purpose:       Account for ticks that elapsed while SysTick was      */
+/*                 suppressed. Caller guarantees no sleeping task expires*/
+/*                 within the elapsed ticks.                             */
+/*  Arguments:     U4 numTicks:                                          */
+/*                    Number of elapsed ticks.                           */
+/*  Return:        N/A                                                   */
 /*************************************************************************/
-void vd_OSsch_setReasonForWakeup(U1 reason, struct Sch_Task* wakeupTaskTCB)
+static void vd_sch_tickAdvance(U4 numTicks)
 {
-  OS_CPU_ENTER_CRITICAL();
+  /* Low word wrapped if it is now smaller than the elapsed ticks. */
+  u4_s_tickCntr += numTicks;
   
-  /* Clear OS resource pointer. */
-  wakeupTaskTCB->resource = (void*)NULL;
+  if(u4_s_tickCntr < numTicks)
+  {
+    ++u4_s_tickCntrHigh;
+  }
+  else{}
   
-  /* Remove sleep reason from flags entry in TCB */
-  wakeupTaskTCB->flags &= ~((U1)reason);
+#if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+  /* Idle time is capped at next release, so no entry is passed over. */
+  if(Entry_s_p_scheduleTable != (const OSScheduleEntry*)NULL)
+  {
+    u4_s_tableTick += numTicks;
+    
+    if(u4_s_tableTick >= u4_s_tableHyperperiod)
+    {
+      u4_s_tableTick -= u4_s_tableHyperperiod;
+      u1_s_tableIndex = (U1)ZERO;
+    }
+    else{}
+  }
+  else{}
+#endif
   
-  /* Set the wakeup reason for application to read. */
-  wakeupTaskTCB->wakeReason = reason;
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+  /* Idle time is not charged to any partition. */
+  if(numTicks >= u4_s_partitionFrameTicks)
+  {
+    u4_s_partitionFrameTicks = (U4)SCH_PARTITION_MAJOR_FRAME;
+    vd_sch_partitionReplenish();
+  }
+  else
+  {
+    u4_s_partitionFrameTicks -= numTicks;
+  }
+#endif
   
-  OS_CPU_EXIT_CRITICAL();
+#if(RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE)
+  /* Load window closes on next tick. */
+  u4_s_loadWindowTicks += numTicks;
+#endif
+  
+  /* Sleep list is a delta list. Only the head counter is relative to the current tick. */
+  if(node_s_p_headOfSleepList != (ListNode*)NULL)
+  {
+    node_s_p_headOfSleepList->TCB->sleepCntr -= numTicks;
+  }
+  else{}
 }
+#endif
 
 /*************************************************************************/
-/*  Function Name: vd_OSsch_setReasonForSleep                            */
-/*  Purpose:       Set reason for task sleep according to mask and set   */
-/*                 task to sleep state.                                  */
-/*  Arguments:     void* taskSleepResource:                              */
-/*                       Address of resource task is blocked on.         */
-/*                 U1 resourceType:                                      */
-/*                       Code for resource that task is sleeping on.     */
-/*                 U4 period:                                            */
-/*                       Period to sleep for.                            */
+/*  Function Name: vd_sch_stackGuardFault                                */
+/*  Purpose:       Report task that hit stack guard region, then fault.  */
+/*                 Running task is the offender. Guard is only moved by  */
+/*                 dispatcher after outgoing task stack is written.      */
+/*  Arguments:     N/A                                                   */
 /*  Return:        N/A                                                   */
 /*************************************************************************/
-void vd_OSsch_setReasonForSleep(void* taskSleepResource, U1 resourceType, U4 period)
+#if(RTOS_CONFIG_ENABLE_MPU_STACK_GUARD == RTOS_CONFIG_TRUE)
+static void vd_sch_stackGuardFault(void)
 {
-  /* Don't let scheduler interrupt itself. Ticker keeps ticking. */
-  OS_CPU_ENTER_CRITICAL();
-  
-  tcb_g_p_currentTaskBlock->resource = taskSleepResource;
-  tcb_g_p_currentTaskBlock->flags   |= (U1)resourceType;
-	
-	tcb_g_p_currentTaskBlock->sleepCntr = period; 
-  tcb_g_p_currentTaskBlock->flags    |= (U1)SCH_TASK_FLAG_STS_SLEEP;
-  
-  /* Switch to an active task */
-  vd_OSsch_setNextReadyTaskToRun();
-  OS_CPU_TRIGGER_DISPATCHER();
+#if(RTOS_CONFIG_STACK_FAULT_FUNC == RTOS_CONFIG_TRUE)
+  if(OS_CPU_STACK_GUARD_FAULT() && (tcb_g_p_currentTaskBlock != (Sch_Task*)SCH_TCB_PTR_INIT))
+  {
+    app_OSStackFaultFcn(tcb_g_p_currentTaskBlock->taskID, OS_CPU_FAULT_ADDRESS());
+  }
+  else{}
+#endif
   
-  /* Resume tick interrupts and enable context switch interrupt. */
-  OS_CPU_EXIT_CRITICAL();
+  OSTaskFault();
 }
+#endif
 
 /*************************************************************************/
-/*  Function Name: u1_OSsch_setNewPriority                               */
-/*  Purpose:       Function to change task priority in support of        */
-/*                 priority inheritance. Internal use only. Internal     */
-/*                 module must ensure that no two active tasks share     */
-/*                 the same priority value at any time.                  */
-/*  Arguments:     Sch_Task* tcb:                                        */
-/*                           Pointer to TCB to have priority changed.    */
-/*                 U1 newPriority:                                       */
-/*                                                                       */
-/*  Return:        U1: Previous priority value.                          */
+/*  Function Name: u1_sch_checkStack                                     */
+/*  Purpose:       Check watermark on task stacks.                       */
+/*  Arguments:     U1 taskIndex:                                         */
+/*                    Task ID to be checked.                             */
+/*  Return:        SCH_TRUE or SCH_FALSE                                 */
 /*************************************************************************/
-U1 u1_OSsch_setNewPriority(struct Sch_Task* tcb, U1 newPriority)
+#if(SCH_STACK_LIMIT_MARK == RTOS_CONFIG_TRUE)
+static U1 u1_sch_checkStack(U1 taskIndex)
 {
-  U1 u1_t_prevPrio;
+  return(*SchTask_s_as_taskList[taskIndex].topOfStack != (OS_STACK)SCH_TOP_OF_STACK_MARK);
+}
+#endif
+
+/*************************************************************************/
+/*  Function Name: vd_sch_stackScan                                      */
+/*  Purpose:       Check a bounded number of painted stack words and     */
+/*                 lower minimum free space of task being scanned. Each  */
+/*                 task is scanned from the end of its stack up to its   */
+/*                 previous minimum, then the next TCB slot is scanned.  */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+#if(RTOS_CONFIG_ENABLE_STACK_WATERMARK == RTOS_CONFIG_TRUE)
+static void vd_sch_stackScan(void)
+{
+  U4        u4_t_budget;
+  Sch_Task* tcb_t_p_task;
+  OS_CPU_CRITICAL_ALLOC();
+  
+  u4_t_budget = (U4)SCH_STACK_SCAN_WORDS;
   
+  /* Task may be deleted or restarted by an interrupt while its stack is read. */
   OS_CPU_ENTER_CRITICAL();
   
-  /* If task is suspended or sleeping then simply change priority. */
-  if(tcb->flags & (U1)SCH_TASK_FLAG_STS_CHECK)
-  {
-    u1_t_prevPrio = tcb->priority;
-    tcb->priority = newPriority;
-  }
-  else
+  while(u4_t_budget != (U4)ZERO)
   {
-    /* Remove node from current position. */
-    vd_list_removeNode(&node_s_p_headOfReadyList, Node_s_ap_mapTaskIDToTCB[tcb->taskID]);
+    tcb_t_p_task = &SchTask_s_as_taskList[u1_s_stackScanSlot];
     
-    /* Change priority. */
-    u1_t_prevPrio = tcb->priority;
-    tcb->priority = newPriority;
-    
-    /* Add back into list in order. */
-    vd_list_addTaskByPrio(&node_s_p_headOfReadyList, Node_s_ap_mapTaskIDToTCB[tcb->taskID]);
-    
-    /* Is new priority higher priority than current task ? */
-    if(node_s_p_headOfReadyList->TCB != tcb_g_p_currentTaskBlock)
-    { 
-      /* Set global task pointer to new task control block */
-      tcb_g_p_nextTaskBlock = node_s_p_headOfReadyList->TCB;
+    /* Move to next slot when this one is unused or fully scanned. */
+    if((tcb_t_p_task->taskID == (U1)SCH_INVALID_TASK_ID) || (u4_s_stackScanIndex >= tcb_t_p_task->stackMinFree))
+    {
+      u4_s_stackScanIndex = (U4)ZERO;
+      u1_s_stackScanSlot  = (U1)((u1_s_stackScanSlot + ONE) % (U1)SCH_MAX_NUM_TASKS);
       
-      OS_CPU_TRIGGER_DISPATCHER();
+      /* At most one slot per pass, so a pass with no tasks is still bounded. */
+      u4_t_budget = (U4)ZERO;
+    }
+    /* First word that has been written is the new high-water mark. */
+    else if(SCH_STACK_WORD_FROM_END(tcb_t_p_task, u4_s_stackScanIndex) != (OS_STACK)SCH_TOP_OF_STACK_MARK)
+    {
+      tcb_t_p_task->stackMinFree = u4_s_stackScanIndex;
     }
     else
     {
-      
+      ++u4_s_stackScanIndex;
+      --u4_t_budget;
     }
   }
   
   OS_CPU_EXIT_CRITICAL();
-  
-  return (u1_t_prevPrio);
 }
+#endif
 
 /*************************************************************************/
-/*  Function Name: vd_OSsch_taskSleep                                    */
-/*  Purpose:       Suspend current task for a specified amount of time.  */
-/*  Arguments:     U4 u4_period:                                         */
-/*                    Time units to suspend for.                         */
+/*  Function Name: vd_sch_scheduleTableTick                              */
+/*  Purpose:       Release tasks of table entries at current position in */
+/*                 hyperperiod, then advance position. Only entries at   */
+/*                 this offset are visited. Task not waiting in          */
+/*                 vd_OSsch_scheduleTableWait() is left as it is and the */
+/*                 release counts as an overrun. Called from SysTick     */
+/*                 with interrupts disabled.                             */
+/*  Arguments:     N/A                                                   */
 /*  Return:        N/A                                                   */
 /*************************************************************************/
-void vd_OSsch_taskSleep(U4 period)
+#if(RTOS_CONFIG_ENABLE_SCHEDULE_TABLE == RTOS_CONFIG_TRUE)
+static void vd_sch_scheduleTableTick(void)
 {
-  /* Don't let scheduler interrupt itself. Ticker keeps ticking. */
-  OS_CPU_ENTER_CRITICAL();
-  
-  tcb_g_p_currentTaskBlock->sleepCntr = period; 
-  tcb_g_p_currentTaskBlock->flags    |= (U1)SCH_TASK_FLAG_STS_SLEEP;
+  U1        u1_t_taskID;
+  Sch_Task* tcb_t_p_task;
   
-  /* Switch to an active task */
-  vd_OSsch_setNextReadyTaskToRun();
-  OS_CPU_TRIGGER_DISPATCHER();
-
-  /* Resume tick interrupts and enable context switch interrupt. */
-  OS_CPU_EXIT_CRITICAL();
+  if(Entry_s_p_scheduleTable != (const OSScheduleEntry*)NULL)
+  {
+    while((u1_s_tableIndex < u1_s_tableNumEntries) && (Entry_s_p_scheduleTable[u1_s_tableIndex].offset == u4_s_tableTick))
+    {
+      u1_t_taskID = Entry_s_p_scheduleTable[u1_s_tableIndex].taskID;
+      
+      /* Task may have been deleted since table was started. */
+      if(Node_s_ap_mapTaskIDToTCB[u1_t_taskID] != (ListNode*)NULL)
+      {
+        tcb_t_p_task = Node_s_ap_mapTaskIDToTCB[u1_t_taskID]->TCB;
+        
+        /* Task running, sleeping or blocked on a resource has not finished its previous release. */
+        if(tcb_t_p_task->tableWait && (tcb_t_p_task->flags & (U1)SCH_TASK_FLAG_STS_SUSPENDED))
+        {
+          tcb_t_p_task->tableWait = (U1)SCH_FALSE;
+          vd_sch_taskWake(Node_s_ap_mapTaskIDToTCB[u1_t_taskID]);
+        }
+        else
+        {
+          ++u4_s_tableOverruns;
+        }
+      }
+      else{}
+      
+      ++u1_s_tableIndex;
+    }
+    
+    if(++u4_s_tableTick >= u4_s_tableHyperperiod)
+    {
+      u4_s_tableTick  = (U4)ZERO;
+      u1_s_tableIndex = (U1)ZERO;
+    }
+    else{}
+  }
+  else{}
 }
 
 /*************************************************************************/
-/*  Function Name: u4_OSsch_taskSleepSetFreq                             */
-/*  Purpose:       Used to set task to sleep such that task will run at a*/
-/*                 set frequency.                                        */
-/*  Arguments:     U4 nextWakeTime:                                      */
-/*                    Time to wake up at (in ticks).                     */
-/*  Return:        U4 u4_t_wakeTime:                                     */
-/*                    Tick value that task was most recently woken at.   */
+/*  Function Name: u4_sch_scheduleTableTicksToNext                       */
+/*  Purpose:       Number of ticks until SysTick that makes next table   */
+/*                 release.                                              */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U4: Number of ticks. SCH_TICKLESS_NO_WAKEUP_PENDING   */
+/*                 if no table is running.                               */
 /*************************************************************************/
-U4 u4_OSsch_taskSleepSetFreq(U4 nextWakeTime)
+#if(RTOS_CONFIG_ENABLE_TICKLESS_IDLE == RTOS_CONFIG_TRUE)
+static U4 u4_sch_scheduleTableTicksToNext(void)
 {
-  /* Don't let scheduler interrupt itself. Ticker keeps ticking. */
-  OS_CPU_ENTER_CRITICAL();
-
-  /* Handle tick roll-over. */
-  if(nextWakeTime > u4_s_tickCntr)
+  U4 u4_t_ticks;
+  
+  if(Entry_s_p_scheduleTable == (const OSScheduleEntry*)NULL)
   {
-    tcb_g_p_currentTaskBlock->sleepCntr = nextWakeTime - u4_s_tickCntr; 
+    u4_t_ticks = (U4)SCH_TICKLESS_NO_WAKEUP_PENDING;
+  }
+  else if(u1_s_tableIndex < u1_s_tableNumEntries)
+  {
+    u4_t_ticks = Entry_s_p_scheduleTable[u1_s_tableIndex].offset - u4_s_tableTick + ONE;
   }
   else
   {
-    tcb_g_p_currentTaskBlock->sleepCntr = ((U4)SCH_MAX_NUM_TICK - u4_s_tickCntr) + nextWakeTime;
+    /* All entries of this hyperperiod released. Next release is first entry of next hyperperiod. */
+    u4_t_ticks = u4_s_tableHyperperiod - u4_s_tableTick + Entry_s_p_scheduleTable[ZERO].offset + ONE;
   }
   
-  tcb_g_p_currentTaskBlock->flags |= (U1)SCH_TASK_FLAG_STS_SLEEP;
-  
-  /* Switch to an active task */
-  vd_OSsch_setNextReadyTaskToRun();
-  OS_CPU_TRIGGER_DISPATCHER();
-  
-  /* Resume tick interrupts and enable context switch interrupt. */
-  OS_CPU_EXIT_CRITICAL();
-
-  return(u4_s_tickCntr);  
+  return (u4_t_ticks);
 }
+#endif
+#endif
 
 /*************************************************************************/
-/*  Function Name: vd_OSsch_taskWake                                     */
-/*  Purpose:       Wake specified task from sleep or suspended state.    */
-/*  Arguments:     U1 taskID:                                            */
-/*                    Task ID to be woken from sleep or suspend state.   */
+/*  Function Name: vd_sch_partitionTick                                  */
+/*  Purpose:       Charge tick to partition of interrupted task and      */
+/*                 throttle partition if its budget is used up. Budgets  */
+/*                 are replenished at end of each major frame. Called    */
+/*                 from SysTick with interrupts disabled.                */
+/*  Arguments:     N/A                                                   */
 /*  Return:        N/A                                                   */
 /*************************************************************************/
-void vd_OSsch_taskWake(U1 taskID)
-{  
-  OS_CPU_ENTER_CRITICAL();
+#if(RTOS_CONFIG_ENABLE_PARTITIONS == RTOS_CONFIG_TRUE)
+static void vd_sch_partitionTick(void)
+{
+  U1             u1_t_partition;
+  Sch_Partition* part_t_p_partition;
   
-  /* Check that task is not already in ready state. */
-  if(Node_s_ap_mapTaskIDToTCB[taskID]->TCB->flags & (U1)SCH_TASK_FLAG_STS_CHECK)
+  u1_t_partition = tcb_g_p_currentTaskBlock->partition;
+  
+  if(u1_t_partition != (U1)SCH_NO_PARTITION)
   {
-    /* If task is blocked on resource, then tell resource that task has timed out. */
-    if(Node_s_ap_mapTaskIDToTCB[taskID]->TCB->resource != SCH_NULL_PTR)
-    {
-      vd_OSsch_taskSleepTimeoutHandler(Node_s_ap_mapTaskIDToTCB[taskID]->TCB);
-    }
-    else
-    {
-      /* Task not blocked on resource. */
-    }
+    part_t_p_partition = &Part_s_as_partitions[u1_t_partition];
     
-    Node_s_ap_mapTaskIDToTCB[taskID]->TCB->sleepCntr  =   (U4)ZERO; 
-    Node_s_ap_mapTaskIDToTCB[taskID]->TCB->flags     &= ~((U1)(SCH_TASK_FLAG_STS_SLEEP|SCH_TASK_FLAG_STS_SUSPENDED));
-    
-#if(RTOS_CONFIG_CALC_TASK_CPU_LOAD == RTOS_CONFIG_TRUE)
-    /* Check if CPU was previously idle, make calculation if so. */
-    if(tcb_g_p_currentTaskBlock == (Node_s_ap_mapTaskIDToTCB[SCH_BG_TASK_ID]->TCB))
+    if(part_t_p_partition->remaining != (U4)ZERO)
     {
-      OS_s_cpuData.CPUIdlePercent.CPU_idleRunning += (u1_cpu_getPercentOfTick() - OS_s_cpuData.CPUIdlePercent.CPU_idlePrevTimestamp);
+      --(part_t_p_partition->remaining);
     }
-    else {}
-#endif
-    
-    /* Remove task from wait list */
-    vd_list_removeNode(&node_s_p_headOfWaitList, Node_s_ap_mapTaskIDToTCB[taskID]); 
-    
-    /* Add woken task to ready queue */
-    vd_list_addTaskByPrio(&node_s_p_headOfReadyList, Node_s_ap_mapTaskIDToTCB[taskID]);
+    else{}
     
-    /* Is woken up task higher priority than current task ? */
-    if(node_s_p_headOfReadyList->TCB != tcb_g_p_currentTaskBlock)
-    { 
-      /* Set global task pointer to new task control block */
-      tcb_g_p_nextTaskBlock = node_s_p_headOfReadyList->TCB;
-      
-      OS_CPU_TRIGGER_DISPATCHER();
-    }
-    else
+    /* Woken tasks of a throttled partition are parked on release, so this is reached once per frame. */
+    if((part_t_p_partition->remaining == (U4)ZERO) && ((u4_s_partitionThrottleMask & ((U4)ONE << u1_t_partition)) == (U4)ZERO))
     {
+      u4_s_partitionThrottleMask |= ((U4)ONE << u1_t_partition);
+      ++(part_t_p_partition->exhaustCount);
       
+      vd_sch_partitionThrottle(u1_t_partition);
     }
+    else{}
   }
-  else
-  {
-    /* Task is not in sleep or suspended state. Do nothing. */
-  }/* Node_s_ap_mapTaskIDToTCB[taskID]->TCB->flags & (U1)SCH_TASK_FLAG_STS_CHECK */
+  else{}
   
-  OS_CPU_EXIT_CRITICAL();
+  if(--u4_s_partitionFrameTicks == (U4)ZERO)
+  {
+    u4_s_partitionFrameTicks = (U4)SCH_PARTITION_MAJOR_FRAME;
+    vd_sch_partitionReplenish();
+  }
+  else{}
 }
 
 /*************************************************************************/
-/*  Function Name: vd_OSsch_taskSuspend                                  */
-/*  Purpose:       Suspend current task for a specified amount of time.  */
-/*  Arguments:     U1 taskIndex:                                         */
-/*                    Task ID to be suspended.                           */
+/*  Function Name: vd_sch_partitionThrottle                              */
+/*  Purpose:       Park all ready tasks of a partition until replenish.  */
+/*                 Sleeping and blocked tasks are parked when they are   */
+/*                 released. Call with interrupts disabled.              */
+/*  Arguments:     U1 partitionID:                                       */
+/*                    ID of partition.                                   */
 /*  Return:        N/A                                                   */
 /*************************************************************************/
-void vd_OSsch_taskSuspend(U1 taskIndex)
+static void vd_sch_partitionThrottle(U1 partitionID)
 {
-  ListNode* node_t_p_suspendTask;
-  
-  OS_CPU_ENTER_CRITICAL();
+  Sch_Task* tcb_t_p_task;
+  ListNode* node_t_p_task;
   
-  node_t_p_suspendTask = Node_s_ap_mapTaskIDToTCB[taskIndex];
-  
-  if((node_t_p_suspendTask->TCB->flags & (U1)SCH_TASK_FLAG_STS_CHECK) != (U1)SCH_TASK_FLAG_STS_SUSPENDED)
+  for(tcb_t_p_task = Part_s_as_partitions[partitionID].members; tcb_t_p_task != (Sch_Task*)NULL; tcb_t_p_task = tcb_t_p_task->partitionNext)
   {
-    Node_s_ap_mapTaskIDToTCB[taskIndex]->TCB->flags |= (U1)SCH_TASK_FLAG_STS_SUSPENDED;
-    vd_list_removeNode(&node_s_p_headOfReadyList, node_t_p_suspendTask); 
-    vd_list_addNodeToEnd(&node_s_p_headOfWaitList, node_t_p_suspendTask); 
+    if((tcb_t_p_task->flags & (U1)SCH_TASK_FLAG_STS_CHECK) == (U1)ZERO)
+    {
+      node_t_p_task = Node_s_ap_mapTaskIDToTCB[tcb_t_p_task->taskID];
+      
+      vd_sch_readyQueueRemove(node_t_p_task);
+      
+#if(RTOS_CONFIG_ENABLE_PREEMPTION_THRESHOLD == RTOS_CONFIG_TRUE)
+      vd_sch_thresholdLower(tcb_t_p_task);
+#endif
+      
+      (void)u1_sch_partitionPark(node_t_p_task);
+    }
+    else{}
   }
-  else{}
-
-  /* Is task suspending itself or another task? */
-  if(node_t_p_suspendTask->TCB == tcb_g_p_currentTaskBlock)
+  
+  /* Interrupted task may have been parked. */
+  if(tcb_sch_readyQueueHighest() != tcb_g_p_currentTaskBlock)
   {
-    /* Switch to an active task */
-    tcb_g_p_nextTaskBlock = node_s_p_headOfReadyList->TCB;
-    OS_CPU_TRIGGER_DISPATCHER();
+    tcb_g_p_nextTaskBlock = tcb_sch_readyQueueHighest();
+    
+    vd_sch_requestDispatch();
   }
   else{}
-  
-  /* Resume tick interrupts and enable context switch interrupt. */
-  OS_CPU_EXIT_CRITICAL();
 }
 
 /*************************************************************************/
-/*  Function Name: vd_OSsch_suspendScheduler                             */
-/*  Purpose:       Turn off scheduler interrupts and reset ticker.       */
+/*  Function Name: vd_sch_partitionReplenish                             */
+/*  Purpose:       Refill budget of every partition and make tasks that  */
+/*                 were parked ready. Task suspended by application      */
+/*                 while throttled stays suspended. Call with interrupts */
+/*                 disabled.                                             */
 /*  Arguments:     N/A                                                   */
 /*  Return:        N/A                                                   */
 /*************************************************************************/
-void vd_OSsch_suspendScheduler(void)
+static void vd_sch_partitionReplenish(void)
 {
-  vd_cpu_suspendScheduler();
+  U1        u1_t_index;
+  Sch_Task* tcb_t_p_task;
+  ListNode* node_t_p_task;
+  
+  for(u1_t_index = (U1)ZERO; u1_t_index < (U1)SCH_NUM_PARTITIONS; u1_t_index++)
+  {
+    Part_s_as_partitions[u1_t_index].remaining = Part_s_as_partitions[u1_t_index].budget;
+    
+    if(u4_s_partitionThrottleMask & ((U4)ONE << u1_t_index))
+    {
+      for(tcb_t_p_task = Part_s_as_partitions[u1_t_index].members; tcb_t_p_task != (Sch_Task*)NULL; tcb_t_p_task = tcb_t_p_task->partitionNext)
+      {
+        if(tcb_t_p_task->throttled)
+        {
+          node_t_p_task = Node_s_ap_mapTaskIDToTCB[tcb_t_p_task->taskID];
+          
+          tcb_t_p_task->throttled  = (U1)SCH_FALSE;
+          tcb_t_p_task->flags     &= ~((U1)SCH_TASK_FLAG_STS_SUSPENDED);
+          vd_list_removeNode(&node_s_p_headOfSuspendList, node_t_p_task);
+          vd_sch_readyQueueInsert(node_t_p_task);
+        }
+        else{}
+      }
+    }
+    else{}
+  }
+  
+  if(u4_s_partitionThrottleMask != (U4)ZERO)
+  {
+    u4_s_partitionThrottleMask = (U4)ZERO;
+    
+    if(tcb_sch_readyQueueHighest() != tcb_g_p_currentTaskBlock)
+    {
+      tcb_g_p_nextTaskBlock = tcb_sch_readyQueueHighest();
+      
+      vd_sch_requestDispatch();
+    }
+    else{}
+  }
+  else{}
 }
 
 /*************************************************************************/
-/*  Function Name: vd_OSsch_systemTick_ISR                               */
-/*  Purpose:       Handle system tick operations and run scheduler.      */
-/*  Arguments:     N/A                                                   */
-/*  Return:        N/A                                                   */
+/*  Function Name: u1_sch_partitionPark                                  */
+/*  Purpose:       Put task of an exhausted partition in suspend list    */
+/*                 until budget is replenished. Task must not be in any  */
+/*                 scheduler list. Call with interrupts disabled.        */
+/*  Arguments:     ListNode* taskNode:                                   */
+/*                    Scheduler list node of task.                       */
+/*  Return:        SCH_TRUE if task was parked, otherwise SCH_FALSE and  */
+/*                 caller makes task ready.                              */
 /*************************************************************************/
-__irq void vd_OSsch_systemTick_ISR(void)
+static U1 u1_sch_partitionPark(ListNode* taskNode)
 {
-  U1 u1_t_prioMask;
-
-  u1_t_prioMask = u1_OSsch_interruptEnter();
+  U1 u1_t_parked;
   
-  /* Increment ticks but cap at max (0xFFFFFFFF rounded down to nearest 100). */
-  u4_s_tickCntr = (u4_s_tickCntr + 1) % (U4)SCH_MAX_NUM_TICK;
-  
-#if(RTOS_CONFIG_CALC_TASK_CPU_LOAD == RTOS_CONFIG_TRUE)
-  /* Check if CPU was previously idle, make calculation if so. */
-  if(tcb_g_p_currentTaskBlock == (Node_s_ap_mapTaskIDToTCB[SCH_BG_TASK_ID]->TCB))
-  {
-    OS_s_cpuData.CPUIdlePercent.CPU_idleRunning += ((U1)SCH_ONE_HUNDRED_PERCENT - OS_s_cpuData.CPUIdlePercent.CPU_idlePrevTimestamp);
-  }
-  else{}
+  u1_t_parked = (U1)SCH_FALSE;
   
-  if((u4_s_tickCntr % (U4)SCH_HUNDRED_TICKS) == (U4)ZERO)
+  if((taskNode->TCB->partition != (U1)SCH_NO_PARTITION) && (u4_s_partitionThrottleMask & ((U4)ONE << taskNode->TCB->partition)))
   {
-    OS_s_cpuData.CPUIdlePercent.CPU_idleAvg     = (U1)(OS_s_cpuData.CPUIdlePercent.CPU_idleRunning/(U4)SCH_HUNDRED_TICKS);
-    OS_s_cpuData.CPUIdlePercent.CPU_idleRunning = (U1)ZERO;
+    taskNode->TCB->flags     |= (U1)SCH_TASK_FLAG_STS_SUSPENDED;
+    taskNode->TCB->throttled  = (U1)SCH_TRUE;
+    vd_list_addNodeToFront(&node_s_p_headOfSuspendList, taskNode);
+    
+    u1_t_parked = (U1)SCH_TRUE;
   }
   else{}
   
-  OS_s_cpuData.CPUIdlePercent.CPU_idlePrevTimestamp = (U1)ZERO;
-#endif  
-  
-  vd_OSsch_periodicScheduler();
-
-  /* Resume tick interrupts and enable context switch interrupt. */
-  vd_OSsch_interruptExit(u1_t_prioMask);
+  return (u1_t_parked);
 }
 
 /*************************************************************************/
-/*  Function Name: vd_OSsch_setNextReadyTaskToRun                        */
-/*  Purpose:       Select next task to run.                              */
-/*  Arguments:     N/A                                                   */
+/*  Function Name: vd_sch_partitionRemoveMember                          */
+/*  Purpose:       Remove task from member list of its partition. Call   */
+/*                 with interrupts disabled.                             */
+/*  Arguments:     Sch_Task* taskTCB:                                    */
+/*                    Pointer to TCB of task.                            */
 /*  Return:        N/A                                                   */
 /*************************************************************************/
-static void vd_OSsch_setNextReadyTaskToRun(void)
+static void vd_sch_partitionRemoveMember(Sch_Task* taskTCB)
 {
-  ListNode* node_t_p_moveToWaitList;
-
-  /* Remove node of task that was previously executing */
-  node_t_p_moveToWaitList = node_list_removeFirstNode(&node_s_p_headOfReadyList);
+  Sch_Task** tcb_t_pp_link;
   
-  /* Move previous node to wait list */
-  vd_list_addNodeToFront(&node_s_p_headOfWaitList, node_t_p_moveToWaitList);
-  
-  tcb_g_p_nextTaskBlock = node_s_p_headOfReadyList->TCB;
+  if(taskTCB->partition != (U1)SCH_NO_PARTITION)
+  {
+    tcb_t_pp_link = &Part_s_as_partitions[taskTCB->partition].members;
+    
+    while((*tcb_t_pp_link != (Sch_Task*)NULL) && (*tcb_t_pp_link != taskTCB))
+    {
+      tcb_t_pp_link = &((*tcb_t_pp_link)->partitionNext);
+    }
+    
+    if(*tcb_t_pp_link == taskTCB)
+    {
+      *tcb_t_pp_link = taskTCB->partitionNext;
+    }
+    else{}
+    
+    taskTCB->partition     = (U1)SCH_NO_PARTITION;
+    taskTCB->partitionNext = (Sch_Task*)NULL;
+  }
+  else{}
 }
+#endif
 
 /*************************************************************************/
-/*  Function Name: vd_OSsch_taskSleepTimeoutHandler                      */
-/*  Purpose:       Tell resources that blocked task has timed out.       */
-/*  Arguments:     Sch_Task* taskTCB:                                    */
-/*                           Pointer to task control block.              */
+/*  Function Name: vd_sch_periodicStatsClear                             */
+/*  Purpose:       Clear timing statistics of a periodic task.           */
+/*  Arguments:     Sch_Periodic* periodic:                               */
+/*                    Periodic data of task.                             */
 /*  Return:        N/A                                                   */
 /*************************************************************************/
-static void vd_OSsch_taskSleepTimeoutHandler(Sch_Task* taskTCB)
-{        
-  /* Task has timed out. Determine if due to manual sleep or resource */
-  switch(taskTCB->flags & (U1)SCH_TASK_RESOURCE_SLEEP_CHECK_MASK)
-  {
-    /* Remove task from resource's blocked list */
-#if(RTOS_CFG_OS_MAILBOX_ENABLED == RTOS_CONFIG_TRUE)
-    case (U1)SCH_TASK_FLAG_SLEEP_MBOX:
-      vd_OSmbox_blockedTaskTimeout((Mailbox*)taskTCB->resource);
-      taskTCB->resource = (void*)NULL;
-      break;
-#endif          
-#if(RTOS_CFG_OS_QUEUE_ENABLED == RTOS_CONFIG_TRUE)            
-    case (U1)SCH_TASK_FLAG_SLEEP_QUEUE:
-      vd_OSqueue_blockedTaskTimeout((Queue*)taskTCB->resource, taskTCB);
-      taskTCB->resource = (void*)NULL;
-      break;
-#endif   
-#if(RTOS_CFG_OS_SEMAPHORE_ENABLED == RTOS_CONFIG_TRUE)            
-    case (U1)SCH_TASK_FLAG_SLEEP_SEMA:
-      vd_OSsema_blockedTimeout((Semaphore*)taskTCB->resource, taskTCB);
-      taskTCB->resource = (void*)NULL;
-      break;
-#endif         
-#if(RTOS_CFG_OS_FLAGS_ENABLED == RTOS_CONFIG_TRUE)            
-    case (U1)SCH_TASK_FLAG_SLEEP_FLAGS:
-      vd_OSflags_pendTimeout((FlagsObj*)taskTCB->resource, taskTCB);
-      taskTCB->resource = (void*)NULL;
-      break;
-#endif         
-#if(RTOS_CFG_OS_MUTEX_ENABLED == RTOS_CONFIG_TRUE)
-    case (U1)SCH_TASK_FLAG_SLEEP_MUTEX:
-      vd_OSmutex_blockedTimeout((Mutex*)taskTCB->resource, taskTCB);
-      taskTCB->resource = (void*)NULL;
-      break;
-#endif    
-    case (U1)ZERO:
-      /* Manual sleep time out */
-      break;  
-
-    default:
-      OSTaskFault(); /* If code execution reaches this point it is a bug */
-      break;             
-  }          
+#if(RTOS_CONFIG_ENABLE_PERIODIC_TASKS == RTOS_CONFIG_TRUE)
+static void vd_sch_periodicStatsClear(Sch_Periodic* periodic)
+{
+  periodic->releases       = (U4)ZERO;
+  periodic->completions    = (U4)ZERO;
+  periodic->maxJitter      = (U4)ZERO;
+  periodic->maxResponse    = (U4)ZERO;
+  periodic->responseTotal  = (U8)ZERO;
+  periodic->overruns       = (U4)ZERO;
+  periodic->deadlineMisses = (U4)ZERO;
 }
+#endif
 
 /*************************************************************************/
-/*  Function Name: vd_OSsch_periodicScheduler                            */
-/*  Purpose:       Scheduler algorithm called to check if task is ready. */
+/*  Function Name: vd_sch_runTimeAccount                                 */
+/*  Purpose:       Charge cycles elapsed since last accounting point to  */
+/*                 running task. Interrupt time is charged to the task   */
+/*                 that was interrupted. Call with interrupts disabled.  */
 /*  Arguments:     N/A                                                   */
 /*  Return:        N/A                                                   */
 /*************************************************************************/
-static void vd_OSsch_periodicScheduler(void)
+#if(RTOS_CONFIG_ENABLE_TASK_RUNTIME_STATS == RTOS_CONFIG_TRUE)
+static void vd_sch_runTimeAccount(void)
 {
-  ListNode* node_t_p_check;
-  ListNode* node_t_p_changeListNode;
-  Sch_Task* tcb_t_p_currentTCB;
+  U4 u4_t_now;
+  U4 u4_t_elapsed;
   
-  if(node_s_p_headOfWaitList == (ListNode*)NULL)
+  /* Unsigned subtraction handles cycle counter roll-over. */
+  u4_t_now              = OS_CPU_GET_CYCLE_COUNT();
+  u4_t_elapsed          = u4_t_now - u4_s_lastSwitchCycles;
+  u4_s_lastSwitchCycles = u4_t_now;
+  
+  /* No task is running before first dispatch. */
+  if(tcb_g_p_currentTaskBlock != (Sch_Task*)NULL)
   {
-    /* No tasks to process. Return immediately. */  
+    tcb_g_p_currentTaskBlock->runCycles    += (U8)u4_t_elapsed;
+    tcb_g_p_currentTaskBlock->windowCycles += u4_t_elapsed;
+    u4_s_burstCycles                       += u4_t_elapsed;
   }
-  else
-  {
-    node_t_p_check = node_s_p_headOfWaitList;
-    
-    /* Check each node that is not suspended. Suspended tasks always held at end of waiting list */
-    while(node_t_p_check != (ListNode*)NULL)
-    {
-      tcb_t_p_currentTCB = node_t_p_check->TCB;
-      
-      if(tcb_t_p_currentTCB->flags & (U1)SCH_TASK_FLAG_STS_SUSPENDED)
-      {
-        /* All waiting tasks have been checked */
-        break;
-      }
-      /* Decrement sleep counter and check if zero */
-      else if((--(tcb_t_p_currentTCB->sleepCntr) == (U1)ZERO))
-      {  
-#if(RTOS_RESOURCES_CONFIGURED)  
-        vd_OSsch_taskSleepTimeoutHandler(tcb_t_p_currentTCB);
-#endif        
-        /* Update flags and wake reason to TIMEOUT */
-        tcb_t_p_currentTCB->wakeReason = (U1)SCH_TASK_WAKEUP_SLEEP_TIMEOUT;
-        tcb_t_p_currentTCB->flags     &= ~((U1)(SCH_TASK_FLAG_STS_SLEEP | SCH_TASK_RESOURCE_SLEEP_CHECK_MASK));
-            
-        /* Save node to be moved to ready list */
-        node_t_p_changeListNode = node_t_p_check;
-        
-        /* Move to next node in wait list */
-        node_t_p_check = node_t_p_check->nextNode;
-        
-        /* Remove from waiting list and add to ready queue by priority. */
-        vd_list_removeNode(&node_s_p_headOfWaitList, node_t_p_changeListNode);
-        vd_list_addTaskByPrio(&node_s_p_headOfReadyList, node_t_p_changeListNode);      
-      }
-      else
-      {      
-        /* Move to next node in wait list */
-        node_t_p_check = node_t_p_check->nextNode;
-      }        
-    }
-    
-    /* Is first task in ready queue the same as before tick? */
-    if(node_s_p_headOfReadyList->TCB == tcb_g_p_currentTaskBlock)
-    {  
-      /* Do nothing, return to current task. */
-    }
-    else
-    {
-      /* Set global task pointer to new task control block */
-      tcb_g_p_nextTaskBlock = node_s_p_headOfReadyList->TCB;
-
-      /* Set bit for pendSV to run when CPU is ready */
-      OS_CPU_TRIGGER_DISPATCHER();
-    }
-  } /* node_s_p_headOfWaitList == NULL */
+  else{}
 }
 
 /*************************************************************************/
-/*  Function Name: vd_OSsch_background                                   */
-/*  Purpose:       Background task when no others are scheduled.         */
+/*  Function Name: vd_sch_runTimeLoadWindow                              */
+/*  Purpose:       Close load window. Compute load of each task over the */
+/*                 window and start a new one. Called from tick ISR.     */
 /*  Arguments:     N/A                                                   */
 /*  Return:        N/A                                                   */
 /*************************************************************************/
-static void vd_OSsch_background(void)
+static void vd_sch_runTimeLoadWindow(void)
 {
   U1 u1_t_index;
-
-  for(;;)
-  {     
-#if(RTOS_CONFIG_ENABLE_STACK_OVERFLOW_DETECT == RTOS_CONFIG_TRUE)
-    for(u1_t_index = ZERO; u1_t_index < u1_s_numTasks; u1_t_index++)
-    {
-      if(u1_sch_checkStack(u1_t_index))
-      {
-        OSTaskFault();
-      }
-      else{}
-    }
-#endif
-#if(RTOS_CFG_OS_MEM_ENABLED == RTOS_CONFIG_TRUE)
-    if(u1_OSMem_maintenance())
+  U4 u4_t_cyclesPerPercent;
+  
+  vd_sch_runTimeAccount();
+  
+  /* Running task may never be switched out. Track its burst here as well. */
+  if(u4_s_burstCycles > tcb_g_p_currentTaskBlock->maxBurstCycles)
+  {
+    tcb_g_p_currentTaskBlock->maxBurstCycles = u4_s_burstCycles;
+  }
+  else{}
+  
+  /* Divide window length once so that no 64-bit math is needed per task. */
+  u4_t_cyclesPerPercent      = (u4_s_lastSwitchCycles - u4_s_loadWindowStartCycles)/(U4)SCH_ONE_HUNDRED_PERCENT;
+  u4_s_loadWindowStartCycles = u4_s_lastSwitchCycles;
+  u4_s_loadWindowTicks       = (U4)ZERO;
+  
+  for(u1_t_index = (U1)ZERO; u1_t_index < (U1)SCH_MAX_NUM_TASKS; u1_t_index++)
+  {
+    if(u4_t_cyclesPerPercent != (U4)ZERO)
     {
-      OSTaskFault();
+      SchTask_s_as_taskList[u1_t_index].loadPercent = (U1)(SchTask_s_as_taskList[u1_t_index].windowCycles/u4_t_cyclesPerPercent);
     }
     else{}
-#endif    
-#if (RTOS_CONFIG_CALC_TASK_CPU_LOAD == RTOS_CONFIG_TRUE)
-    OS_s_cpuData.CPUIdlePercent.CPU_idlePrevTimestamp = u1_cpu_getPercentOfTick();
-#endif
     
-#if(RTOS_CONFIG_ENABLE_BACKGROUND_IDLE_SLEEP == RTOS_CONFIG_TRUE)
-  #if(RTOS_CONFIG_PRESLEEP_FUNC == RTOS_CONFIG_TRUE || RTOS_CONFIG_POSTSLEEP_FUNC == RTOS_CONFIG_TRUE)
-    u1_s_sleepState = (U1)SCH_CPU_SLEEPING;
-  #endif
-  #if(RTOS_CONFIG_PRESLEEP_FUNC == RTOS_CONFIG_TRUE)
-    /* pre-sleep hook function defined by application */
-    app_OSPreSleepFcn();
-  #endif
-    WaitForInterrupt();
-#endif
+    SchTask_s_as_taskList[u1_t_index].windowCycles = (U4)ZERO;
   }
 }
-
-/*************************************************************************/
-/*  Function Name: u1_sch_checkStack                                     */
-/*  Purpose:       Check watermark on task stacks.                       */
-/*  Arguments:     U1 taskIndex:                                         */
-/*                    Task ID to be checked.                             */
-/*  Return:        SCH_TRUE or SCH_FALSE                                 */
-/*************************************************************************/
-#if(RTOS_CONFIG_ENABLE_STACK_OVERFLOW_DETECT == RTOS_CONFIG_TRUE)
-static U1 u1_sch_checkStack(U1 taskIndex)
-{
-  return(*SchTask_s_as_taskList[taskIndex].topOfStack != (OS_STACK)SCH_TOP_OF_STACK_MARK);
-}
 #endif
 
 /***********************************************************************************************/
@@ -1004,3 +5033,129 @@ static U1 u1_sch_checkStack(U1 taskIndex)
 /*                                                                                             */
 /* 2.5                5/4/20      Changing SCH_BG_TASK_ID caused bug in CPU load calculation.  */
 /*                                Bug is now resolved.                                         */
+/*                                                                                             */
+/* 2.6                10/16/26    Ready list replaced with bitmap-indexed ready queue. Insert,  */
+/*                                remove and highest priority lookup are O(1) for all priority */
+/*                                levels. Task creation denied for priority above 0xF0.        */
+/*                                                                                             */
+/* 2.7                10/16/26    Wait list split into a delta list of sleeping tasks ordered  */
+/*                                by wake time and an unordered suspend list. SysTick only     */
+/*                                decrements the head of the sleep list, so a tick with no     */
+/*                                expiry is O(1). A zero sleep period now sleeps one tick.     */
+/*                                Suspending a sleeping task removes it from the sleep list.   */
+/*                                                                                             */
+/* 2.8                10/16/26    Added tickless idle. Background task stretches SysTick up to */
+/*                                the next wake-up in the sleep list and corrects the tick     */
+/*                                count when the CPU wakes.                                    */
+/*                                                                                             */
+/* 2.9                10/16/26    Added optional round-robin scheduling. Ready lists are FIFO  */
+/*                                per priority level, running task is rotated to the tail of   */
+/*                                its level when its time quantum expires or it yields.        */
+/*                                                                                             */
+/* 3.0                10/16/26    Added optional earliest-deadline-first scheduling. Ready     */
+/*                                queue is ordered by absolute deadline, which is computed     */
+/*                                each time a task is released. Tasks without a deadline run   */
+/*                                by priority when no deadline task is ready.                  */
+/*                                                                                             */
+/* 3.1                10/16/26    Added per-task run-time accounting. Dispatcher hook charges  */
+/*                                cycle counter time to each task. Total cycles, longest burst */
+/*                                and load over 100 ticks available per task.                  */
+/*                                                                                             */
+/* 3.2                10/16/26    Added task delete and restart. TCB slots are taken from a    */
+/*                                free slot bitmap so deleted tasks' slots and IDs are reused. */
+/*                                                                                             */
+/* 3.3                10/16/26    Added preemption threshold. Running task is raised to its    */
+/*                                threshold in the ready queue. Run-to-completion tasks may    */
+/*                                share a stack, their frame is built each time they are       */
+/*                                dispatched. Returning from a task routine no longer faults.  */
+/*                                                                                             */
+/* 3.4                10/16/26    Added nestable scheduler lock. Preemption requests made      */
+/*                                while locked are deferred to the final unlock. Interrupts    */
+/*                                are not masked.                                              */
+/*                                                                                             */
+/* 3.5                10/16/26    Added direct-to-task notifications. Notification value and   */
+/*                                pending state are kept in the TCB, a waiting task is woken   */
+/*                                without going through a resource blocked list.               */
+/*                                                                                             */
+/* 3.6                10/16/26    Added stack watermark. Whole stack is painted when task is   */
+/*                                created and background task measures minimum free space a    */
+/*                                few words per pass.                                          */
+/*                                                                                             */
+/* 3.7                10/16/26    Tick count extended to 64 bits and wraps at 2^32 in the low  */
+/*                                word. Tick ISR no longer divides. Sleep until a set tick     */
+/*                                uses a wrap-safe compare and does not sleep if it is late.   */
+/*                                                                                             */
+/* 3.8                10/16/26    Added optional kernel tick task. SysTick only counts time    */
+/*                                and wakes the task, which processes sleep expiry and         */
+/*                                resource timeouts with interrupts enabled between expiries.  */
+/*                                                                                             */
+/* 3.9                10/16/26    Added periodic tasks. Kernel releases task at fixed absolute */
+/*                                ticks and records jitter, response time, overruns and        */
+/*                                deadline misses.                                             */
+/*                                                                                             */
+/* 4.0                10/16/26    Added partitions. Each partition has a CPU budget per major  */
+/*                                frame charged by SysTick. Ready tasks of a partition are     */
+/*                                suspended when its budget runs out and resumed at the next   */
+/*                                major frame.                                                 */
+/*                                                                                             */
+/* 4.1                10/16/26    Added static schedule table. SysTick releases table tasks by */
+/*                                index at fixed offsets in a hyperperiod.                     */
+/*                                                                                             */
+/* 4.2                10/16/26    Added wake batch. Tasks released by one ISR are made ready   */
+/*                                under one critical section with one preemption check.        */
+/*                                                                                             */
+/* 4.3                10/16/26    Added public task priority change and priority trace buffer. */
+/*                                                                                             */
+/* 4.4                10/16/26    Added idle job queue run by background task within a cycle   */
+/*                                budget.                                                      */
+/*                                                                                             */
+/* 4.5                10/16/26    Added idle governor. Sleep state picked from predicted idle  */
+/*                                length, with residency and misprediction statistics.         */
+/*                                                                                             */
+/* 4.6                10/16/26    Critical sections raise BASEPRI to kernel interrupt priority */
+/*                                and save previous mask in caller. Tickless sleep uses        */
+/*                                OS_CPU_CRITICAL_WAIT_FOR_INTERRUPT().                        */
+/*                                                                                             */
+/* 4.7                10/16/26    Added MPU stack guard. Guard region moved to incoming task   */
+/*                                stack limit by dispatcher, replacing periodic stack check.   */
+/*                                Fault reports task to app_OSStackFaultFcn().                 */
+/*                                                                                             */
+/* 4.8                10/16/26    Kernel trace events recorded.                                */
+/*                                                                                             */
+/* 4.9                10/16/26    Profiler init. Tick ISR entered via profiler shim.           */
+/*                                                                                             */
+/* 4.10               10/16/26    Application task create and priority change denied at        */
+/*                                background task priority 0xF0 and kernel task IDs. Kernel    */
+/*                                tasks created through internal path.                         */
+/*                                                                                             */
+/* 4.11               10/16/26    Task wake and suspend ignore kernel task IDs and deleted     */
+/*                                tasks. Tick task woken and suspended through internal path.  */
+/*                                                                                             */
+/* 4.12               10/16/26    Task delete and restart return status. Denied if task owns a */
+/*                                mutex or deletes or restarts itself while holding scheduler  */
+/*                                lock.                                                        */
+/*                                                                                             */
+/* 4.13               10/16/26    Tick task woken only when head of sleep list is due,         */
+/*                                processes one expiry per critical section with saved mask.   */
+/*                                Tick task priority reserved.                                 */
+/*                                                                                             */
+/* 4.14               10/16/26    Partitions keep member list and are throttled and            */
+/*                                replenished directly in SysTick critical section. Task       */
+/*                                released in exhausted partition waits for replenish.         */
+/*                                                                                             */
+/* 4.15               10/16/26    Schedule table wakes only tasks waiting for release. Release */
+/*                                of a running, sleeping or blocked task counts as overrun and */
+/*                                leaves it as it is.                                          */
+/*                                                                                             */
+/* 4.16               10/16/26    EDF deadline recomputed only when task wakes after ending    */
+/*                                its job by sleep or self-suspend, or on new job. Period is   */
+/*                                minimum time between releases.                               */
+/*                                                                                             */
+/* 4.17               10/16/26    Added deadline inheritance for mutex holders under EDF.      */
+/*                                                                                             */
+/* 4.18               10/16/26    Set task priority denied if another task has priority and    */
+/*                                round-robin is disabled. Priority change of task blocked on  */
+/*                                mutex updates holder inheritance.                            */
+/*                                                                                             */
+/* 4.19               10/16/26    Scheduler lock count changed in critical section and owner   */
+/*                                recorded. Lock defers preemption only of its owner.          */
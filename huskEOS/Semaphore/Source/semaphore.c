@@ -56,6 +56,7 @@ U1 u1_OSsema_init(OSSemaphore** semaphore, S1 initValue)
          U1 u1_t_index;
          U1 u1_t_returnSts; 
   static U1 u1_s_numSemaAllocated = (U1)ZERO;
+  OS_SCH_CRITICAL_ALLOC();
   
   u1_t_returnSts = (U1)SEMA_NO_SEMA_OBJECTS_AVAILABLE;
   
@@ -104,6 +105,7 @@ U1 u1_OSsema_init(OSSemaphore** semaphore, S1 initValue)
 U1 u1_OSsema_wait(OSSemaphore* semaphore, U4 blockPeriod)
 {
   U1 u1_t_returnSts;
+  OS_SCH_CRITICAL_ALLOC();
   
   u1_t_returnSts = (U1)SEMA_SEMAPHORE_TAKEN;
   
@@ -160,6 +162,7 @@ U1 u1_OSsema_wait(OSSemaphore* semaphore, U4 blockPeriod)
 U1 u1_OSsema_check(OSSemaphore* semaphore)
 {
   U1 u1_t_sts;
+  OS_SCH_CRITICAL_ALLOC();
   
   OS_SCH_ENTER_CRITICAL();
   
@@ -188,6 +191,8 @@ U1 u1_OSsema_check(OSSemaphore* semaphore)
 /*************************************************************************/
 void vd_OSsema_post(OSSemaphore* semaphore)
 {
+  OS_SCH_CRITICAL_ALLOC();
+  
   OS_SCH_ENTER_CRITICAL();
   
   ++(semaphore->sema);
@@ -214,6 +219,7 @@ void vd_OSsema_post(OSSemaphore* semaphore)
 void vd_OSsema_blockedTimeout(OSSemaphore* semaphore, struct Sch_Task* taskTCB)
 {
   ListNode* node_t_tempPtr;
+  OS_SCH_CRITICAL_ALLOC();
   
   OS_SCH_ENTER_CRITICAL();
   
@@ -287,3 +293,6 @@ static void vd_OSsema_unblockTask(OSSemaphore* semaphore)
 /*                                                                                             */
 /* 1.0                7/26/19     Block list structure changed to utilize list module.         */
 /*                                                                                             */
+/* 1.1                10/16/26    Critical sections save interrupt mask in caller with         */
+/*                                OS_SCH_CRITICAL_ALLOC().                                     */
+/*                                                                                             */
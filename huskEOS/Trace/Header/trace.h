@@ -0,0 +1,76 @@
+/*************************************************************************/
+/*  File Name:  trace.h                                                  */
+/*  Purpose:    Header file for kernel trace recorder.                   */
+/*  Created by: Garrett Sculthorpe on 10/16/26                           */
+/*  Copyright © 2019 Garrett Sculthorpe and Darren Cicala.               */
+/*              All rights reserved.                                     */
+/*************************************************************************/
+
+#ifndef trace_h
+#if(RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE)
+#define trace_h
+
+#include "rtos_cfg.h"
+
+/*************************************************************************/
+/*  Definitions                                                          */
+/*************************************************************************/
+/* Record event codes. Must match decoder in Tools/trace_decode.py. */
+#define TRACE_EVT_TASK_SWITCH          (1)   /* taskID: outgoing task.    data: incoming task ID.              */
+#define TRACE_EVT_TASK_WAKE            (2)   /* taskID: woken task.       data: wake reason (SCH_TASK_WAKEUP_*). */
+#define TRACE_EVT_TASK_SLEEP           (3)   /* taskID: sleeping task.    data: resource type, 0 for delay.     */
+#define TRACE_EVT_PRIO_INHERIT         (4)   /* taskID: task changed.     data: old priority << 8 | new.        */
+#define TRACE_EVT_QUEUE_PUT            (5)   /* taskID: current task.     data: queue number.                   */
+#define TRACE_EVT_QUEUE_GET            (6)   /* taskID: current task.     data: queue number.                   */
+#define TRACE_EVT_ISR_ENTER            (7)   /* taskID: interrupted task. data: exception number.               */
+#define TRACE_EVT_ISR_EXIT             (8)   /* taskID: interrupted task. data: exception number.               */
+
+#define TRACE_TASK_ID_NONE             (0xFF)
+
+/*************************************************************************/
+/*  Data Types                                                           */
+/*************************************************************************/
+typedef struct OSTraceRecord
+{
+  U4 timestamp;                      /* CPU cycle counter. Wraps. */
+  U1 event;
+  U1 taskID;
+  U2 data;
+}
+OSTraceRecord;
+
+/*************************************************************************/
+/*  Public Functions                                                     */
+/*************************************************************************/
+/*************************************************************************/
+/*  Function Name: u4_OStrace_read                                       */
+/*  Purpose:       Copy most recent trace records, oldest first. Records */
+/*                 are 8 bytes, little-endian, and may be written as-is  */
+/*                 to a file for Tools/trace_decode.py. Records written  */
+/*                 while copy is in progress may be torn.                */
+/*  Arguments:     OSTraceRecord* records:                               */
+/*                    Destination array.                                 */
+/*                 U4 maxRecords:                                        */
+/*                    Number of records destination can hold.            */
+/*  Return:        U4: Number of records copied.                         */
+/*************************************************************************/
+U4 u4_OStrace_read(OSTraceRecord* records, U4 maxRecords);
+
+/*************************************************************************/
+/*  Function Name: u4_OStrace_getNumRecorded                             */
+/*  Purpose:       Get number of records written since init, including  */
+/*                 records that have since been overwritten.             */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U4: Number of records. Wraps.                         */
+/*************************************************************************/
+U4 u4_OStrace_getNumRecorded(void);
+
+/*************************************************************************/
+/*  Global Variables                                                     */
+/*************************************************************************/
+
+#else
+#warning "TRACE MODULE NOT ENABLED"
+
+#endif /* Conditional compile */
+#endif
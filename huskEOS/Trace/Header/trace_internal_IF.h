@@ -0,0 +1,45 @@
+/*************************************************************************/
+/*  File Name:  trace_internal_IF.h                                      */
+/*  Purpose:    Kernel access routines for trace recorder.               */
+/*  Created by: Garrett Sculthorpe on 10/16/26                           */
+/*  Copyright © 2019 Garrett Sculthorpe and Darren Cicala.               */
+/*              All rights reserved.                                     */
+/*************************************************************************/
+
+#ifndef trace_internal_IF_h
+#define trace_internal_IF_h
+
+#include "rtos_cfg.h"
+
+/*************************************************************************/
+/*  Public Functions                                                     */
+/*************************************************************************/
+
+/*************************************************************************/
+/*  Function Name: vd_OStrace_init                                       */
+/*  Purpose:       Initialize trace recorder. Called by vd_OS_init().    */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OStrace_init(void);
+
+/*************************************************************************/
+/*  Function Name: vd_OStrace_record                                     */
+/*  Purpose:       Write one record to trace buffer. Callable from task  */
+/*                 or ISR, with or without a critical section.           */
+/*  Arguments:     U1 event:                                             */
+/*                    TRACE_EVT_* code.                                  */
+/*                 U1 taskID:                                            */
+/*                    Task the event refers to.                          */
+/*                 U2 data:                                              */
+/*                    Event specific data.                               */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OStrace_record(U1 event, U1 taskID, U2 data);
+
+/*************************************************************************/
+/*  Global Variables                                                     */
+/*************************************************************************/
+
+
+#endif
@@ -0,0 +1,136 @@
+/*************************************************************************/
+/*  File Name: trace.c                                                   */
+/*  Purpose: Kernel event recorder. Binary records written to a RAM ring */
+/*           buffer, decoded on host by Tools/trace_decode.py.           */
+/*  Created by: Garrett Sculthorpe on 10/16/26.                          */
+/*  Copyright © 2019 Garrett Sculthorpe and Darren Cicala.               */
+/*              All rights reserved.                                     */
+/*************************************************************************/
+
+#include "rtos_cfg.h"
+
+#if(RTOS_CFG_OS_TRACE_ENABLED == RTOS_CONFIG_TRUE)
+
+/*************************************************************************/
+/*  Includes                                                             */
+/*************************************************************************/
+#include "trace_internal_IF.h"
+#include "trace.h"
+#include "sch_internal_IF.h"
+#include "sch.h"
+
+/*************************************************************************/
+/*  Definitions                                                          */
+/*************************************************************************/
+#define TRACE_BUFFER_SIZE              (RTOS_CFG_TRACE_BUFFER_SIZE)
+#define TRACE_INDEX_MASK               (TRACE_BUFFER_SIZE - 1)
+
+#if((TRACE_BUFFER_SIZE == 0) || ((TRACE_BUFFER_SIZE & TRACE_INDEX_MASK) != 0))
+  #error "RTOS_CFG_TRACE_BUFFER_SIZE MUST BE A POWER OF TWO"
+#endif
+
+/*************************************************************************/
+/*  Static Global Variables, Constants                                   */
+/*************************************************************************/
+static OSTraceRecord    Trace_s_as_buffer[TRACE_BUFFER_SIZE];
+static volatile U4      u4_s_traceHead;                            /* Total records claimed. Next record index is head & mask. */
+
+
+/*************************************************************************/
+
+/*************************************************************************/
+/*  Function Name: vd_OStrace_init                                       */
+/*  Purpose:       Initialize trace recorder. Called by vd_OS_init().    */
+/*  Arguments:     N/A                                                   */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OStrace_init(void)
+{
+  u4_s_traceHead = (U4)ZERO;
+}
+
+/*************************************************************************/
+/*  Function Name: vd_OStrace_record                                     */
+/*  Purpose:       Write one record to trace buffer. Slot is claimed     */
+/*                 with an atomic increment, so an interrupt recording   */
+/*                 an event in between takes the next slot. No critical */
+/*                 section is used.                                      */
+/*  Arguments:     U1 event:                                             */
+/*                    TRACE_EVT_* code.                                  */
+/*                 U1 taskID:                                            */
+/*                    Task the event refers to.                          */
+/*                 U2 data:                                              */
+/*                    Event specific data.                               */
+/*  Return:        N/A                                                   */
+/*************************************************************************/
+void vd_OStrace_record(U1 event, U1 taskID, U2 data)
+{
+  OSTraceRecord* rec_t_p_record;
+
+  rec_t_p_record = &Trace_s_as_buffer[OS_CPU_ATOMIC_INCREMENT(&u4_s_traceHead) & (U4)TRACE_INDEX_MASK];
+
+  rec_t_p_record->timestamp = OS_CPU_GET_CYCLE_COUNT();
+  rec_t_p_record->event     = event;
+  rec_t_p_record->taskID    = taskID;
+  rec_t_p_record->data      = data;
+}
+
+/*************************************************************************/
+/*  Function Name: u4_OStrace_read                                       */
+/*  Purpose:       Copy most recent trace records, oldest first.         */
+/*  Arguments:     OSTraceRecord* records:                               */
+/*                    Destination array.                                 */
+/*                 U4 maxRecords:                                        */
+/*                    Number of records destination can hold.            */
+/*  Return:        U4: Number of records copied.                         */
+/*************************************************************************/
+U4 u4_OStrace_read(OSTraceRecord* records, U4 maxRecords)
+{
+  U4 u4_t_head;
+  U4 u4_t_count;
+  U4 u4_t_index;
+
+  u4_t_head  = u4_s_traceHead;
+  u4_t_count = u4_t_head;
+
+  /* Older records have been overwritten once buffer wraps. */
+  if(u4_t_count > (U4)TRACE_BUFFER_SIZE)
+  {
+    u4_t_count = (U4)TRACE_BUFFER_SIZE;
+  }
+  else{}
+
+  if(u4_t_count > maxRecords)
+  {
+    u4_t_count = maxRecords;
+  }
+  else{}
+
+  for(u4_t_index = (U4)ZERO; u4_t_index < u4_t_count; u4_t_index++)
+  {
+    records[u4_t_index] = Trace_s_as_buffer[(u4_t_head - u4_t_count + u4_t_index) & (U4)TRACE_INDEX_MASK];
+  }
+
+  return (u4_t_count);
+}
+
+/*************************************************************************/
+/*  Function Name: u4_OStrace_getNumRecorded                             */
+/*  Purpose:       Get number of records written since init.             */
+/*  Arguments:     N/A                                                   */
+/*  Return:        U4: Number of records. Wraps.                         */
+/*************************************************************************/
+U4 u4_OStrace_getNumRecorded(void)
+{
+  return (u4_s_traceHead);
+}
+
+#endif /* Conditional compile */
+
+/***********************************************************************************************/
+/* History                                                                                     */
+/***********************************************************************************************/
+/* Version            Date        Description                                                  */
+/*                                                                                             */
+/* 0.1                10/16/26    Module implemented.                                          */
+/*                                                                                             */